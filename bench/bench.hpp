@@ -0,0 +1,201 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+struct Benchmark {
+    std::string name;
+    std::function<void()> func;
+};
+
+inline std::vector<Benchmark>& getBenchmarks() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct BenchRegistrar {
+    BenchRegistrar(const std::string& name, std::function<void()> func) {
+        getBenchmarks().push_back({name, func});
+    }
+};
+
+// Réglages de la ligne de commande (voir bench_main.cpp)
+struct Options {
+    std::string filter;          // Ne lance que les BENCH dont le nom contient filter
+    int warmup = 1;              // Appels non mesurés avant les répétitions
+    int repetitions = 20;        // Répétitions mesurées quand run() n'en propose pas
+    bool repetitionsSet = false; // --repetitions donné : remplace aussi la valeur propre à un cas
+    std::string jsonPath;        // Résultats écrits en JSON si non vide
+    std::string baselinePath;    // JSON d'un run précédent à comparer
+    double threshold = 10.0;     // Médiane plus lente de plus de threshold % : régression
+};
+
+inline Options& options() {
+    static Options opts;
+    return opts;
+}
+
+// Statistiques d'un cas, en nanosecondes par appel de fn
+struct Result {
+    std::string name;
+    std::string unit;
+    double items = 0;
+    int repetitions = 0;
+    double min = 0, median = 0, mean = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+inline std::vector<Result>& getResults() {
+    static std::vector<Result> results;
+    return results;
+}
+
+// Empêche le compilateur d'éliminer un calcul dont le résultat n'est pas utilisé
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Percentile par rang le plus proche sur des échantillons triés
+inline double percentile(const std::vector<double>& sorted, double q) {
+    const size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+// Exécute fn() plusieurs fois, affiche la médiane et le p90 et garde les statistiques.
+// items = unités traitées par appel ; repetitions : valeur par défaut du cas (les mesures de
+// latence, un appel très court par échantillon, en demandent davantage), 0 : celle de Options.
+// --repetitions l'emporte toujours.
+inline void run(const std::string& name, double items, const std::string& unit, const std::function<void()>& fn,
+                int repetitions = 0) {
+    const Options& opts = options();
+    if (repetitions <= 0 || opts.repetitionsSet) repetitions = opts.repetitions;
+    for (int w = 0; w < opts.warmup; ++w) fn(); // Chauffe (caches, pages, sélection des noyaux)
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = name;
+    result.unit = unit;
+    result.items = items;
+    result.repetitions = repetitions;
+    result.min = samples.front();
+    result.max = samples.back();
+    result.median = samples[samples.size() / 2];
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    result.p90 = percentile(samples, 0.90);
+    result.p99 = percentile(samples, 0.99);
+    getResults().push_back(result);
+
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << result.median << " ns"
+              << std::setw(14) << result.p90 << " ns p90"
+              << std::setw(16) << std::setprecision(1) << items * 1e9 / result.median << " " << unit << "/s" << std::endl;
+}
+
+inline std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// Un objet par ligne dans "benchmarks" : readBaseline() n'a pas besoin d'un parseur JSON complet
+inline bool writeJson(const std::string& path, const std::vector<std::pair<std::string, std::string>>& context) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) return false;
+    file << "{\n  \"context\": {";
+    for (size_t i = 0; i < context.size(); ++i) {
+        file << (i ? ", " : "") << jsonString(context[i].first) << ": " << jsonString(context[i].second);
+    }
+    file << "},\n  \"benchmarks\": [\n";
+    const auto& results = getResults();
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        char numbers[512];
+        std::snprintf(numbers, sizeof(numbers),
+                      "\"items\": %.17g, \"repetitions\": %d, \"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, "
+                      "\"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, \"items_per_second\": %.1f",
+                      r.items, r.repetitions, r.min, r.median, r.mean, r.p90, r.p99, r.max, r.items * 1e9 / r.median);
+        file << "    {\"name\": " << jsonString(r.name) << ", \"unit\": " << jsonString(r.unit) << ", " << numbers << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file.flush());
+}
+
+// Médianes d'un fichier écrit par writeJson, par nom de cas
+inline std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> medians;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const std::string nameKey = "{\"name\": \"";
+        const std::string medianKey = "\"median_ns\": ";
+        const size_t name = line.find(nameKey);
+        const size_t median = line.find(medianKey);
+        if (name == std::string::npos || median == std::string::npos) continue;
+        const size_t begin = name + nameKey.size();
+        const size_t end = line.find('"', begin);
+        if (end == std::string::npos) continue;
+        medians[line.substr(begin, end - begin)] = std::atof(line.c_str() + median + medianKey.size());
+    }
+    return medians;
+}
+
+// Compare les médianes au baseline ; renvoie le nombre de régressions
+inline int compareBaseline(const std::map<std::string, double>& baseline, double threshold) {
+    int regressions = 0;
+    std::cout << "\nComparison with baseline (regression above +" << std::setprecision(1) << threshold << "%):" << std::endl;
+    for (const Result& r : getResults()) {
+        auto it = baseline.find(r.name);
+        std::cout << std::left << std::setw(40) << r.name << std::right;
+        if (it == baseline.end() || it->second <= 0) {
+            std::cout << std::setw(14) << "new" << std::endl;
+            continue;
+        }
+        const double change = (r.median / it->second - 1.0) * 100.0;
+        const bool regression = change > threshold;
+        regressions += regression;
+        std::cout << std::setw(14) << std::setprecision(0) << it->second << " ns" << std::setw(14) << r.median << " ns"
+                  << std::setw(10) << std::showpos << std::setprecision(1) << change << std::noshowpos << "%"
+                  << (regression ? "  REGRESSION" : "") << std::endl;
+    }
+    return regressions;
+}
+
+inline int runBenchmarks() {
+    for (const auto& b : getBenchmarks()) {
+        if (!options().filter.empty() && b.name.find(options().filter) == std::string::npos) continue;
+        b.func();
+    }
+    return 0;
+}
+
+} // namespace bench
+
+#define BENCH(name) \
+    void name(); \
+    static bench::BenchRegistrar bench_registrar_##name(#name, name); \
+    void name()
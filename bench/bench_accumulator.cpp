@@ -0,0 +1,53 @@
+#include "bench.hpp"
+#include "../include/Accumulator.hpp"
+#include "../include/FENParser.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Aller-retour de cavalier : chaque position diffère de la précédente d'un coup
+const std::vector<std::string> LINE = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnbqkbnr/pppppppp/8/8/8/5N2/PPPPPPPP/RNBQKB1R b KQkq - 1 1",
+    "rnbqkb1r/pppppppp/5n2/8/8/5N2/PPPPPPPP/RNBQKB1R w KQkq - 2 2",
+    "rnbqkb1r/pppppppp/5n2/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 3 2",
+};
+
+} // namespace
+
+// Évaluation de positions voisines : forward complet contre mise à jour incrémentale
+BENCH(AccumulatorMoveSequence) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU);
+    net.addLayer(128, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SIGMOID);
+
+    std::vector<nn::Vector> dense;
+    std::vector<std::vector<int>> sparse(LINE.size());
+    for (size_t p = 0; p < LINE.size(); ++p) {
+        dense.push_back(analyzer::FENParser::fenToVector(LINE[p]));
+        analyzer::FENParser::fenToIndices(LINE[p], sparse[p]);
+    }
+
+    bench::run("position_eval/full_forward", LINE.size(), "positions", [&] {
+        for (const auto& in : dense) bench::doNotOptimize(net.forward(in)[0]);
+    });
+
+    nn::InferenceWorkspace ws = net.makeWorkspace();
+    bench::run("position_eval/workspace_dense", LINE.size(), "positions", [&] {
+        for (const auto& in : dense) bench::doNotOptimize(net.infer(std::span<const nn::Scalar>(in), ws)[0]);
+    });
+    bench::run("position_eval/workspace_sparse", LINE.size(), "positions", [&] {
+        for (const auto& active : sparse) bench::doNotOptimize(net.infer(std::span<const int>(active), ws)[0]);
+    });
+
+    nn::Accumulator acc(net);
+    acc.refresh(sparse.back());
+    bench::run("position_eval/accumulator", LINE.size(), "positions", [&] {
+        for (size_t p = 0; p < sparse.size(); ++p) {
+            acc.transition(sparse[(p + sparse.size() - 1) % sparse.size()], sparse[p]);
+            bench::doNotOptimize(acc.evaluate()[0]);
+        }
+    });
+}
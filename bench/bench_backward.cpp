@@ -0,0 +1,43 @@
+#include "bench.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <vector>
+
+namespace {
+
+constexpr int SAMPLES = 32;
+
+nn::Network makeNetwork() {
+    nn::Network net;
+    net.addLayer(838, 128, nn::ActivationType::RELU);
+    net.addLayer(128, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SIGMOID);
+    return net;
+}
+
+} // namespace
+
+// Backward dense : un échantillon à la fois (forward + accumulateGradients) et par batch
+BENCH(DenseBackward) {
+    nn::Network net = makeNetwork();
+    std::vector<nn::Vector> inputs(SAMPLES, nn::Vector(838, 0.0));
+    for (int s = 0; s < SAMPLES; ++s) {
+        for (int j = s % 13; j < 838; j += 13) inputs[s][j] = 1;
+    }
+    const nn::Vector grad = {0.3, -0.2, 0.1};
+    bench::run("backward/single_sample", SAMPLES, "samples", [&] {
+        for (const auto& in : inputs) {
+            net.forward(in);
+            net.accumulateGradients(grad);
+        }
+    });
+
+    nn::Network batchNet = makeNetwork();
+    nn::Matrix batch(SAMPLES, 838), targets(SAMPLES, 3);
+    for (int s = 0; s < SAMPLES; ++s) {
+        for (int j = 0; j < 838; ++j) batch(s, j) = inputs[s][j];
+        targets(s, s % 3) = 1;
+    }
+    nn::ParallelTrainer trainer(batchNet, 1);
+    bench::run("backward/train_batch_dense", SAMPLES, "samples", [&] { trainer.trainBatch(batch, targets, 0.01); });
+}
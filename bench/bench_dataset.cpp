@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "../include/DataSource.hpp"
+#include "../include/Dataset.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include "../include/Prefetcher.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int POSITIONS = 20000;
+constexpr int BATCH = 32;
+
+const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    "8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59",
+    "rnbqkbnr/pp1ppppp/8/2pP4/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 2",
+    "r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1",
+    "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1",
+};
+const char* LABELS[] = {"Nothing", "Check", "Checkmate"};
+
+// Dataset synthétique au format texte habituel, supprimé à la destruction
+struct SyntheticDataset {
+    std::string path;
+
+    SyntheticDataset() : path((std::filesystem::temp_directory_path() / "my_torch_bench_dataset.txt").string()) {
+        std::mt19937 rng(42);
+        std::ofstream file(path, std::ios::trunc);
+        for (int i = 0; i < POSITIONS; ++i) file << FENS[rng() % FENS.size()] << ' ' << LABELS[rng() % 3] << '\n';
+    }
+    ~SyntheticDataset() { std::remove(path.c_str()); }
+};
+
+} // namespace
+
+// Lecture et encodage d'un dataset texte de 20000 positions
+BENCH(DatasetLoad) {
+    SyntheticDataset dataset;
+    bench::run("dataset_load/dense", POSITIONS, "positions",
+               [&] { bench::doNotOptimize(analyzer::Dataset::load(dataset.path).size()); }, 5);
+    bench::run("dataset_load/sparse", POSITIONS, "positions",
+               [&] { bench::doNotOptimize(analyzer::Dataset::loadSparse(dataset.path).size()); }, 5);
+}
+
+// Époque d'entraînement complète comme train : source en mémoire, préchargement, batches creux
+BENCH(TrainingEpoch) {
+    SyntheticDataset dataset;
+    std::unique_ptr<analyzer::DataSource> data = analyzer::DataSource::open(dataset.path, false);
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU);
+    net.addLayer(128, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SOFTMAX);
+    nn::ParallelTrainer trainer(net, 1);
+
+    bench::run("training_epoch/838_128_64_3", static_cast<double>(data->size()), "samples", [&] {
+        analyzer::Prefetcher batches(*data, 0, data->size(), BATCH);
+        while (const analyzer::Minibatch* batch = batches.next()) {
+            trainer.trainBatch(batch->inputs, batch->targets, 0.01);
+        }
+    }, 5);
+}
@@ -0,0 +1,89 @@
+#include "bench.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/FeatureExtractor.hpp"
+#include "../include/Position.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    "8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59",
+    "rnbqkbnr/pp1ppppp/8/2pP4/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 2",
+};
+
+} // namespace
+
+// Analyse FEN : version historique (stringstream + vecteurs alloués) contre version sans allocation
+BENCH(FenParsing) {
+    const int rounds = 1000;
+    const double positions = rounds * FENS.size();
+
+    bench::run("fen/fenToVector", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& fen : FENS) bench::doNotOptimize(analyzer::FENParser::fenToVector(fen)[0]);
+        }
+    });
+
+    std::vector<int> indices;
+    bench::run("fen/fenToIndices", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& fen : FENS) {
+                indices.clear();
+                analyzer::FENParser::fenToIndices(fen, indices);
+                bench::doNotOptimize(indices.data());
+            }
+        }
+    });
+
+    int buffer[analyzer::FENParser::MAX_ACTIVE];
+    bench::run("fen/toIndices(string_view)", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& fen : FENS) bench::doNotOptimize(analyzer::FENParser::toIndices(std::string_view(fen), buffer));
+        }
+    });
+
+    nn::Vector features(analyzer::FENParser::FEATURE_COUNT);
+    bench::run("fen/toFeatures(span)", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& fen : FENS) bench::doNotOptimize(analyzer::FENParser::toFeatures(fen, features));
+        }
+    });
+}
+
+// Représentation bitboard : construction depuis le FEN, puis extraction seule (base et tous les jeux)
+BENCH(PositionFeatures) {
+    const int rounds = 1000;
+    const double positions = rounds * FENS.size();
+
+    std::vector<analyzer::Position> parsed(FENS.size());
+    bench::run("position/fromFen", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < FENS.size(); ++i) bench::doNotOptimize(analyzer::Position::fromFen(FENS[i], parsed[i]));
+        }
+    });
+
+    int buffer[analyzer::FeatureExtractor::MAX_ACTIVE];
+    const analyzer::FeatureExtractor base;
+    bench::run("position/extract(base)", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& position : parsed) bench::doNotOptimize(base.extract(position, buffer));
+        }
+    });
+
+    const analyzer::FeatureExtractor all(analyzer::FeatureExtractor::ALL);
+    bench::run("position/extract(all)", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& position : parsed) bench::doNotOptimize(all.extract(position, buffer));
+        }
+    });
+
+    bench::run("position/key", positions, "positions", [&] {
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& position : parsed) bench::doNotOptimize(position.key());
+        }
+    });
+}
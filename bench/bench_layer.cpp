@@ -0,0 +1,85 @@
+#include "bench.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Layer.hpp"
+#include "../include/Network.hpp"
+#include <vector>
+
+namespace {
+
+constexpr int SAMPLES = 32;
+
+// Entrée type d'une position : ~1 feature sur 13 active
+nn::Vector makeInput(int size, int shift) {
+    nn::Vector input(size, 0.0);
+    for (int j = shift % 13; j < size; j += 13) input[j] = 1;
+    return input;
+}
+
+// Une couche seule, par échantillon : forward, accumulateGradients puis updateWeights par batch
+void benchLayer(int inputSize, int outputSize, nn::ActivationType activation, const std::string& label) {
+    nn::Layer layer(inputSize, outputSize, activation);
+    std::vector<nn::Vector> inputs;
+    for (int s = 0; s < SAMPLES; ++s) inputs.push_back(makeInput(inputSize, s));
+    const nn::Vector grad(outputSize, 0.01);
+
+    bench::run("layer_" + label + "/forward", SAMPLES, "samples", [&] {
+        for (const auto& in : inputs) bench::doNotOptimize(layer.forward(in)[0]);
+    });
+    bench::run("layer_" + label + "/forward_accumulate", SAMPLES, "samples", [&] {
+        for (const auto& in : inputs) {
+            layer.forward(in);
+            layer.accumulateGradients(grad);
+        }
+    });
+    // Pas de SGD sur des gradients accumulés : remet aussi les accumulateurs à zéro
+    bench::run("layer_" + label + "/update_weights", 1, "updates", [&] { layer.updateWeights(1e-9, SAMPLES); });
+}
+
+} // namespace
+
+// Tailles du réseau par défaut 838-128-64-3
+BENCH(LayerPasses) {
+    benchLayer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU, "838x128");
+    benchLayer(128, 64, nn::ActivationType::RELU, "128x64");
+    benchLayer(64, 3, nn::ActivationType::SIGMOID, "64x3");
+}
+
+// Fin élément par élément d'un forward/backward par batch : peu d'entrées, beaucoup de neurones,
+// pour que l'activation et sa dérivée pèsent face au produit matriciel
+BENCH(ActivationTail) {
+    constexpr int BATCH = 128;
+    const std::pair<nn::ActivationType, const char*> types[] = {
+        {nn::ActivationType::SIGMOID, "sigmoid"}, {nn::ActivationType::RELU, "relu"}, {nn::ActivationType::SOFTMAX, "softmax"}};
+    for (const auto& [type, name] : types) {
+        nn::Layer layer(16, 1024, type);
+        nn::Matrix input(BATCH, 16), grad(BATCH, 1024, 0.01);
+        for (int b = 0; b < BATCH; ++b) {
+            for (int j = 0; j < 16; ++j) input(b, j) = ((b * 7 + j * 3) % 11) / 5.0 - 1.0;
+        }
+        nn::LayerCache cache;
+        nn::LayerGradients grads = layer.makeGradients();
+        bench::run(std::string("activation_") + name + "/forward", BATCH, "samples",
+                   [&] { bench::doNotOptimize(layer.forwardBatch(input, cache)(0, 0)); });
+        bench::run(std::string("activation_") + name + "/forward_backward", BATCH, "samples", [&] {
+            layer.forwardBatch(input, cache);
+            layer.backwardBatch(grad, cache, grads, false);
+        });
+    }
+}
+
+// Latence d'un forward : un échantillon par mesure, d'où les percentiles sur 2000 mesures
+BENCH(NetworkForwardLatency) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU);
+    net.addLayer(128, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SOFTMAX);
+    const nn::Vector input = makeInput(analyzer::FENParser::FEATURE_COUNT, 0);
+    std::vector<int> active;
+    for (int j = 0; j < analyzer::FENParser::FEATURE_COUNT; ++j) {
+        if (input[j] != 0) active.push_back(j);
+    }
+
+    bench::run("network_latency/forward", 1, "positions", [&] { bench::doNotOptimize(net.forward(input)[0]); }, 2000);
+    bench::run("network_latency/infer_sparse", 1, "positions",
+               [&] { bench::doNotOptimize(net.infer(std::span<const int>(active))[0]); }, 2000);
+}
@@ -0,0 +1,76 @@
+#include "bench.hpp"
+#include "../include/Kernels.hpp"
+#include "../include/Types.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: my_torch_bench [--filter <name>] [--warmup N] [--repetitions N] [--json <file>]"
+                 " [--baseline <file>] [--threshold <percent>] [--list]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options& opts = bench::options();
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            opts.filter = argv[++i];
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            opts.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            opts.repetitions = std::max(1, std::atoi(argv[++i]));
+            opts.repetitionsSet = true;
+        } else if (arg == "--json" && i + 1 < argc) {
+            opts.jsonPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            opts.baselinePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            opts.threshold = std::atof(argv[++i]);
+        } else if (arg == "--list") {
+            for (const auto& b : bench::getBenchmarks()) std::cout << b.name << std::endl;
+            return 0;
+        } else {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 84;
+        }
+    }
+
+    // Lu avant le run : un baseline illisible ne doit pas coûter un run complet
+    std::map<std::string, double> baseline;
+    if (!opts.baselinePath.empty()) {
+        baseline = bench::readBaseline(opts.baselinePath);
+        if (baseline.empty()) {
+            std::cerr << "Error: No results in baseline " << opts.baselinePath << std::endl;
+            return 84;
+        }
+    }
+
+    bench::runBenchmarks();
+
+    if (!opts.jsonPath.empty()) {
+        char date[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        const bool written = bench::writeJson(opts.jsonPath, {
+            {"date", date},
+            {"scalar", sizeof(nn::Scalar) == sizeof(float) ? "float" : "double"},
+            {"kernels", nn::kernels::active<nn::Scalar>().name},
+            {"int8_kernels", nn::kernels::activeInt8().name},
+        });
+        if (!written) {
+            std::cerr << "Error: Cannot write " << opts.jsonPath << std::endl;
+            return 84;
+        }
+        std::cerr << "Results written to " << opts.jsonPath << std::endl;
+    }
+
+    // Code 1 : au moins une régression (utilisable tel quel en CI)
+    if (!baseline.empty() && bench::compareBaseline(baseline, opts.threshold) > 0) return 1;
+    return 0;
+}
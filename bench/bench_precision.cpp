@@ -0,0 +1,98 @@
+#include "bench.hpp"
+#include "../include/Kernels.hpp"
+#include "../include/Matrix.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int BATCH = 32;
+const std::vector<int> TOPOLOGY = {838, 128, 64, 3};
+
+// Buffer row-major aligné sur 64 octets, comme nn::Matrix mais pour un type T quelconque
+template <typename T>
+struct Buffer {
+    int rows, cols, stride;
+    std::vector<T, nn::AlignedAllocator<T>> data;
+    Buffer(int r, int c) : rows(r), cols(c), stride((c + 63 / (int)sizeof(T)) / (64 / (int)sizeof(T)) * (64 / (int)sizeof(T))),
+                           data((size_t)r * stride, T(0.01)) {}
+    T* row(int i) { return data.data() + (size_t)i * stride; }
+};
+
+// Passe dense forward + backward (dW et dX) sur la topologie, au niveau des noyaux
+template <typename T>
+void densePass(const nn::kernels::KernelTable<T>& k, std::vector<Buffer<T>>& weights,
+               std::vector<Buffer<T>>& acts, std::vector<Buffer<T>>& grads, std::vector<Buffer<T>>& deltas) {
+    for (size_t l = 0; l < weights.size(); ++l) {
+        auto& w = weights[l]; auto& in = acts[l]; auto& out = acts[l + 1];
+        for (int i = 0; i < w.rows; ++i) {
+            for (int b = 0; b < BATCH; b += 4) {
+                const T* x[4] = {in.row(b), in.row(b + 1), in.row(b + 2), in.row(b + 3)};
+                T o[4];
+                k.dot4(w.row(i), x, w.cols, o);
+                for (int r = 0; r < 4; ++r) out.row(b + r)[i] = o[r] > 0 ? o[r] : 0;
+            }
+        }
+    }
+    for (size_t l = weights.size(); l-- > 0;) {
+        auto& w = weights[l]; auto& in = acts[l]; auto& g = grads[l]; auto& dz = acts[l + 1];
+        for (int i = 0; i < w.rows; ++i) {
+            for (int b = 0; b < BATCH; b += 4) {
+                const T a[4] = {dz.row(b)[i], dz.row(b + 1)[i], dz.row(b + 2)[i], dz.row(b + 3)[i]};
+                const T* x[4] = {in.row(b), in.row(b + 1), in.row(b + 2), in.row(b + 3)};
+                k.axpy4(a, x, g.row(i), w.cols);
+            }
+        }
+        if (l == 0) continue;
+        for (int i = 0; i + 4 <= w.rows; i += 4) {
+            const T* wr[4] = {w.row(i), w.row(i + 1), w.row(i + 2), w.row(i + 3)};
+            for (int b = 0; b < BATCH; ++b) {
+                const T a[4] = {dz.row(b)[i], dz.row(b)[i + 1], dz.row(b)[i + 2], dz.row(b)[i + 3]};
+                k.axpy4(a, wr, deltas[l].row(b), w.cols);
+            }
+        }
+    }
+}
+
+template <typename T>
+void benchPrecision(const std::string& label) {
+    const auto& k = nn::kernels::active<T>();
+    std::vector<Buffer<T>> weights, grads, acts, deltas;
+    acts.emplace_back(BATCH, TOPOLOGY[0]);
+    for (size_t l = 0; l + 1 < TOPOLOGY.size(); ++l) {
+        weights.emplace_back(TOPOLOGY[l + 1], TOPOLOGY[l]);
+        grads.emplace_back(TOPOLOGY[l + 1], TOPOLOGY[l]);
+        acts.emplace_back(BATCH, TOPOLOGY[l + 1]);
+        deltas.emplace_back(BATCH, TOPOLOGY[l]);
+    }
+    bench::run("dense_pass_838_128_64_3/" + label + "/" + k.name, BATCH, "samples",
+               [&] { densePass(k, weights, acts, grads, deltas); bench::doNotOptimize(grads[0].data[0]); });
+}
+
+} // namespace
+
+// Compare float et double sur la même passe dense (mêmes noyaux, même topologie)
+BENCH(PrecisionDensePass) {
+    benchPrecision<double>("double");
+    benchPrecision<float>("float");
+}
+
+// Pas d'entraînement complet du moteur dans le type compilé (make re SCALAR=float pour l'autre)
+BENCH(PrecisionTrainBatch) {
+    nn::Network net;
+    for (size_t l = 0; l + 1 < TOPOLOGY.size(); ++l) {
+        net.addLayer(TOPOLOGY[l], TOPOLOGY[l + 1],
+                     l + 2 == TOPOLOGY.size() ? nn::ActivationType::SIGMOID : nn::ActivationType::RELU);
+    }
+    nn::Matrix inputs(BATCH, TOPOLOGY.front()), targets(BATCH, TOPOLOGY.back());
+    for (int b = 0; b < BATCH; ++b) {
+        for (int j = b % 13; j < TOPOLOGY.front(); j += 13) inputs(b, j) = 1;
+        targets(b, b % 3) = 1;
+    }
+    nn::ParallelTrainer trainer(net, 1);
+    const std::string label = sizeof(nn::Scalar) == sizeof(float) ? "float" : "double";
+    bench::run("train_batch_838_128_64_3/" + label, BATCH, "samples",
+               [&] { trainer.trainBatch(inputs, targets, 0.01); });
+}
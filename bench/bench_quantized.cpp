@@ -0,0 +1,44 @@
+#include "bench.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Network.hpp"
+#include "../include/QuantizedNetwork.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+// Positions aléatoires de ~30 features actives, comme des positions réelles
+nn::SparseBatch makePositions(int rows, unsigned seed) {
+    std::mt19937 rng(seed);
+    nn::SparseBatch batch(analyzer::FENParser::FEATURE_COUNT);
+    std::vector<int> active;
+    for (int r = 0; r < rows; ++r) {
+        active.clear();
+        for (int k = 0; k < 30; ++k) active.push_back(static_cast<int>(rng() % analyzer::FENParser::FEATURE_COUNT));
+        std::sort(active.begin(), active.end());
+        active.erase(std::unique(active.begin(), active.end()), active.end());
+        batch.addRow(active);
+    }
+    return batch;
+}
+
+} // namespace
+
+// Inférence position par position : réseau float contre moteur int8
+BENCH(QuantizedInference) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 256, nn::ActivationType::RELU);
+    net.addLayer(256, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SOFTMAX);
+
+    const nn::SparseBatch positions = makePositions(256, 1);
+    nn::QuantizedNetwork q = nn::QuantizedNetwork::quantize(net, makePositions(1000, 2),
+                                                            nn::QuantizedNetwork::Granularity::CHANNEL);
+
+    bench::run("quantized/float_infer", positions.rows(), "positions", [&] {
+        for (int r = 0; r < positions.rows(); ++r) bench::doNotOptimize(net.infer(positions.row(r))[0]);
+    });
+    bench::run("quantized/int8_infer", positions.rows(), "positions", [&] {
+        for (int r = 0; r < positions.rows(); ++r) bench::doNotOptimize(q.infer(positions.row(r))[0]);
+    });
+}
@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include "../include/SparseBatch.hpp"
+#include <vector>
+
+namespace {
+
+constexpr int BATCH = 32;
+
+nn::SparseBatch makeBatch() {
+    const std::vector<std::string> fens = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1",
+        "r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1",
+    };
+    nn::SparseBatch batch(analyzer::FENParser::FEATURE_COUNT);
+    std::vector<int> indices;
+    for (int b = 0; b < BATCH; ++b) {
+        indices.clear();
+        analyzer::FENParser::fenToIndices(fens[b % fens.size()], indices);
+        batch.addRow(indices);
+    }
+    return batch;
+}
+
+} // namespace
+
+// Première couche 838 -> 128 : produit dense contre somme des colonnes actives
+BENCH(SparseFirstLayer) {
+    nn::Layer layer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU, true);
+    nn::SparseBatch sparse = makeBatch();
+    nn::Matrix dense = sparse.toDense();
+    nn::Matrix grad(BATCH, 128, 0.01);
+    nn::LayerCache cache;
+    nn::LayerGradients grads = layer.makeGradients();
+
+    bench::run("first_layer_forward/dense", BATCH, "samples",
+               [&] { bench::doNotOptimize(layer.forwardBatch(dense, cache)(0, 0)); });
+    bench::run("first_layer_forward/sparse", BATCH, "samples",
+               [&] { bench::doNotOptimize(layer.forwardBatch(sparse, cache)(0, 0)); });
+    bench::run("first_layer_forward_backward/dense", BATCH, "samples", [&] {
+        layer.forwardBatch(dense, cache);
+        layer.backwardBatch(grad, cache, grads);
+    });
+    bench::run("first_layer_forward_backward/sparse", BATCH, "samples", [&] {
+        layer.forwardBatch(sparse, cache);
+        layer.backwardBatch(grad, cache, grads);
+    });
+}
+
+// Pas d'entraînement complet 838-128-64-3 (réduction et mise à jour comprises)
+BENCH(SparseTrainBatch) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 128, nn::ActivationType::RELU);
+    net.addLayer(128, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 3, nn::ActivationType::SIGMOID);
+    nn::SparseBatch sparse = makeBatch();
+    nn::Matrix dense = sparse.toDense();
+    nn::Matrix targets(BATCH, 3);
+    for (int b = 0; b < BATCH; ++b) targets(b, b % 3) = 1;
+
+    nn::ParallelTrainer trainer(net, 1);
+    bench::run("train_batch/dense", BATCH, "samples", [&] { trainer.trainBatch(dense, targets, 0.01); });
+    bench::run("train_batch/sparse", BATCH, "samples", [&] { trainer.trainBatch(sparse, targets, 0.01); });
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "Network.hpp"
+
+namespace nn {
+
+// Accumulateur incrémental (style NNUE) sur la première couche d'un réseau à entrées binaires.
+// Il garde Z1 = B1 + somme des colonnes actives de W1 pour une position. Passer à une position
+// voisine ne coûte que quelques colonnes ajoutées/retirées au lieu du produit complet ;
+// seules les couches suivantes (petites) sont recalculées à chaque évaluation.
+// Copiable : une recherche peut copier l'accumulateur du parent avant de jouer un coup.
+// Le réseau doit survivre à l'accumulateur ; refresh() après toute mise à jour des poids.
+// Les features doivent être dans [0, taille d'entrée) : refresh(), add(), remove() (et donc
+// update() et transition()) lèvent std::out_of_range sinon, comme Layer::infer(span).
+class Accumulator {
+public:
+    // Lève std::invalid_argument si le réseau n'a aucune couche
+    explicit Accumulator(const Network& net);
+
+    // Recalcul complet à partir des features actives (aussi le repli après dérive numérique)
+    void refresh(std::span<const int> active);
+
+    void add(int feature);
+    void remove(int feature);
+    void update(std::span<const int> added, std::span<const int> removed);
+
+    // Passe d'une position à une autre (indices triés) en n'appliquant que la différence
+    void transition(std::span<const int> before, std::span<const int> after);
+
+    std::span<const Scalar> preActivation() const { return z; }
+    size_t updatesSinceRefresh() const { return updates; }
+
+    // Sortie du réseau pour la position courante (valide jusqu'au prochain evaluate)
+    std::span<const Scalar> evaluate();
+
+private:
+    const Scalar* column(int feature) const;   // Colonne de W1, indice vérifié
+
+    const Network* net;
+    std::vector<Scalar> z;                     // Pré-activation de la première couche
+    std::vector<std::vector<Scalar>> hidden;   // Sorties de chaque couche
+    std::vector<int> added, removed;           // Tampons de transition()
+    size_t updates = 0;
+};
+
+} // namespace nn
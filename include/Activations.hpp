@@ -1,17 +1,66 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include <span>
 #include <vector>
+#include "Kernels.hpp"
+#include "Types.hpp"
 
 namespace nn {
 
     class Activations {
     public:
-        static double sigmoid(double x);
-        static double sigmoidDerivative(double x);
-        static double relu(double x);
-        static double reluDerivative(double x);
+        static Scalar sigmoid(Scalar x) { return Scalar(1) / (Scalar(1) + std::exp(-x)); }
+        static Scalar sigmoidDerivative(Scalar x) {
+            const Scalar s = sigmoid(x);
+            return s * (Scalar(1) - s);
+        }
+        static Scalar relu(Scalar x) { return std::max(Scalar(0), x); }
+        static Scalar reluDerivative(Scalar x) { return x > 0 ? Scalar(1) : Scalar(0); }
 
-        static std::vector<double> softmax(const std::vector<double>& x);
+        static std::vector<Scalar> softmax(const std::vector<Scalar>& x);
+        // Sans allocation ; x et out peuvent coïncider
+        static void softmax(std::span<const Scalar> x, std::span<Scalar> out);
         // Note: La dérivée de Softmax est gérée directement dans la loss
     };
 
-} // namespace nn
\ No newline at end of file
+// Politiques d'activation de Layer : le type est choisi une fois par couche (voir withActivation
+// dans Layer.hpp), les boucles élément par élément n'ont plus de branche sur le type.
+// apply : out = f(z) sur n valeurs, z et out peuvent coïncider.
+// delta : dZ = dY * f'(Z), calculé depuis la sortie y gardée du forward (Z n'est pas conservé).
+namespace activation {
+
+struct Sigmoid {
+    static void apply(const kernels::KernelTable<Scalar>& k, const Scalar* z, Scalar* out, int n) {
+        k.sigmoid(z, out, n);
+    }
+    static void delta(const Scalar* grad, const Scalar* y, Scalar* dZ, int n) {
+        for (int i = 0; i < n; ++i) dZ[i] = grad[i] * y[i] * (Scalar(1) - y[i]);
+    }
+};
+
+struct Relu {
+    static void apply(const kernels::KernelTable<Scalar>& k, const Scalar* z, Scalar* out, int n) {
+        k.relu(z, out, n);
+    }
+    static void delta(const Scalar* grad, const Scalar* y, Scalar* dZ, int n) {
+        for (int i = 0; i < n; ++i) {
+            const Scalar g = grad[i];                                         // Lu d'office : sélection sans saut
+            dZ[i] = y[i] > 0 ? g : Scalar(0);
+        }
+    }
+};
+
+// Avec l'entropie croisée, dY est déjà dZ (voir Loss)
+struct Softmax {
+    static void apply(const kernels::KernelTable<Scalar>&, const Scalar* z, Scalar* out, int n) {
+        Activations::softmax(std::span<const Scalar>(z, n), std::span<Scalar>(out, n));
+    }
+    static void delta(const Scalar* grad, const Scalar*, Scalar* dZ, int n) {
+        std::copy(grad, grad + n, dZ);
+    }
+};
+
+} // namespace activation
+
+} // namespace nn
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,22 @@ public:
         double validationSplit = 0.2;
         double lrDecay = 1.0; // 1.0 = no decay
         int decayStep = 10;
+        int threads = 1;      // Threads d'entraînement data-parallel
+        bool streaming = false; // Dataset texte relu du disque à chaque passe au lieu d'être chargé
+        std::string features = "base"; // Voir FeatureExtractor::parse
+        std::string optimizer = "sgd";  // sgd, momentum, nesterov, adam, adamw (voir nn::Optimizer)
+        double momentum = 0.9;
+        double beta1 = 0.9;
+        double beta2 = 0.999;
+        double weightDecay = 0.0;
+        int patience = 0;               // Early stopping après patience époques sans amélioration (0 = désactivé)
+        std::string monitor = "val_acc"; // Critère surveillé : val_acc ou val_loss
+        double minDelta = 0.0;          // Amélioration minimale prise en compte
+        std::string checkpointDir;      // Checkpoints et modèles sauvegardés ici (vide = répertoire courant, sans checkpoint)
+        int keepCheckpoints = 2;        // Checkpoints conservés (0 = tous)
+        std::uint64_t seed = 0;         // Initialisation, découpage et mélange (0 = graine aléatoire)
+        bool shuffle = true;            // Mélange les échantillons d'entraînement à chaque époque
+        bool profile = false;           // Colonnes de débit, de temps par phase et par couche, et de mémoire
     };
 
     int run(int argc, char** argv);
@@ -23,7 +40,15 @@ public:
 
 private:
     void printUsage();
-    void trainModel(const std::string& datasetPath, const Config& config);
+    // resumePath : checkpoint (ou répertoire de checkpoints) à reprendre, vide = nouvel entraînement
+    void trainModel(const std::string& datasetPath, const Config& config, const std::string& resumePath);
+    // Une position par ligne de input ("-" = stdin), une ligne de résultat par position sur stdout
+    int predictStream(const std::string& inputPath, const std::string& modelPath,
+                      const std::string& format, int batchSize);
+    // Quantifie model en int8 (calibration sur la partie entraînement de dataset), compare au modèle
+    // float sur la partie validation puis écrit output. granularity : channel ou layer.
+    int quantizeModel(const std::string& modelPath, const std::string& datasetPath, const std::string& outputPath,
+                      const std::string& granularity, double validationRatio, std::uint64_t seed);
 };
 
 } // namespace analyzer
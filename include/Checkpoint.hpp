@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace nn {
+class Network;
+class Optimizer;
+}
+
+namespace analyzer {
+
+// Progression d'un entraînement, en plus des poids et de l'état de l'optimiseur
+struct TrainingState {
+    int epoch = 0;                // Époques terminées
+    double learningRate = 0.0;    // Taux courant, décroissance déjà appliquée
+    std::string monitor;          // Critère de l'early stopping : val_acc ou val_loss
+    double best = 0.0;            // Meilleure valeur du critère
+    int staleEpochs = 0;          // Époques consécutives sans amélioration
+    std::uint64_t seed = 0;       // Découpage train/validation et mélange de chaque époque
+};
+
+// Un checkpoint est un répertoire <dir>/checkpoint-NNNN contenant model.nn, optimizer.opt et state
+// (clé=valeur). Il est écrit dans un répertoire temporaire, synchronisé (fsync) puis renommé : un
+// checkpoint visible est toujours complet, même si le processus est tué pendant l'écriture. Un
+// checkpoint remplacé est renommé en .old jusqu'à ce que le nouveau soit en place. <dir>/latest nomme le dernier.
+// Les fonctions lèvent std::runtime_error en cas d'échec.
+namespace checkpoint {
+
+// Renvoie le chemin du checkpoint écrit. keep > 0 : ne garde que les keep derniers.
+std::string write(const std::string& dir, const nn::Network& net, const nn::Optimizer& optimizer,
+                  const TrainingState& state, int keep);
+
+// path : un checkpoint, ou un répertoire de checkpoints (le dernier est repris).
+// Remplace les couches de net ; l'optimiseur doit être du même type que celui sauvegardé.
+TrainingState read(const std::string& path, nn::Network& net, nn::Optimizer& optimizer);
+
+// Écrit le modèle (format binaire nn::model) dans un fichier temporaire puis le renomme en path
+void saveModel(const nn::Network& net, const std::string& path);
+
+} // namespace checkpoint
+
+} // namespace analyzer
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include "Dataset.hpp"
+#include "FeatureExtractor.hpp"
+#include "Matrix.hpp"
+#include "PackedDataset.hpp"
+#include "SparseBatch.hpp"
+
+namespace analyzer {
+
+// Minibatch prêt pour l'entraînement : entrées creuses et cibles one-hot
+struct Minibatch {
+    nn::SparseBatch inputs;
+    nn::Matrix targets;
+};
+
+// Source d'échantillons indexés 0..size()-1. fill() est const et réentrant : il est appelé
+// depuis le thread de préchargement (voir Prefetcher) pendant que l'entraînement tourne.
+class DataSource {
+public:
+    virtual ~DataSource() = default;
+
+    virtual std::size_t size() const = 0;
+    virtual int classCount() const = 0;
+    // Classe de l'échantillon i (découpage stratifié)
+    virtual int label(std::size_t i) const = 0;
+    // Encode les échantillons rows, dans cet ordre, dans batch (stockage réutilisé d'un appel à l'autre)
+    virtual void fill(std::span<const std::size_t> rows, Minibatch& batch) const = 0;
+
+    // Choisit l'implémentation : dataset binaire (pack) mappé, sinon texte en mémoire ou en flux.
+    // path suit Dataset::expandPaths ; threads sert au chargement en mémoire ; features choisit
+    // l'encodage des entrées. Lève std::runtime_error si le fichier ne peut pas être ouvert.
+    static std::unique_ptr<DataSource> open(const std::string& path, bool streaming, int threads = 1,
+                                            const FeatureExtractor& features = FeatureExtractor());
+};
+
+// Découpage train/validation en listes d'indices croissants : les échantillons ne sont jamais copiés.
+// Chaque classe est mélangée puis coupée selon validationRatio, elle garde donc la même proportion
+// dans les deux parties. Même source et même état de rng : même découpage.
+struct Split {
+    std::vector<std::size_t> train;
+    std::vector<std::size_t> validation;
+};
+Split stratifiedSplit(const DataSource& source, double validationRatio, std::mt19937_64& rng);
+
+// Dataset texte chargé entièrement (Dataset::loadSparse)
+class MemorySource : public DataSource {
+public:
+    MemorySource(std::vector<SparseSample> samples, int featureCount);
+
+    std::size_t size() const override { return samples.size(); }
+    int classCount() const override;
+    int label(std::size_t i) const override;
+    void fill(std::span<const std::size_t> rows, Minibatch& batch) const override;
+
+private:
+    std::vector<SparseSample> samples;
+    int featureCount;
+};
+
+// Dataset binaire mappé : les pages sont lues à la demande par le noyau. Les features optionnelles
+// sont calculées au remplissage depuis la Position reconstruite.
+class PackedSource : public DataSource {
+public:
+    PackedSource(const std::string& path, const FeatureExtractor& features) : data(path), features(features) {}
+
+    std::size_t size() const override { return data.size(); }
+    int classCount() const override { return data.classCount(); }
+    int label(std::size_t i) const override { return data.label(i); }
+    void fill(std::span<const std::size_t> rows, Minibatch& batch) const override;
+
+private:
+    PackedDataset data;
+    FeatureExtractor features;
+};
+
+// Dataset texte lu depuis le disque à chaque passe. Seul un index des lignes valides
+// (13 octets par position) reste en mémoire ; les FEN sont analysées au remplissage.
+class TextStreamSource : public DataSource {
+public:
+    TextStreamSource(const std::string& path, const FeatureExtractor& features);
+    ~TextStreamSource() override;
+    TextStreamSource(const TextStreamSource&) = delete;
+    TextStreamSource& operator=(const TextStreamSource&) = delete;
+
+    std::size_t size() const override { return starts.size(); }
+    int classCount() const override { return classes; }
+    int label(std::size_t i) const override { return labels[i]; }
+    void fill(std::span<const std::size_t> rows, Minibatch& batch) const override;
+
+private:
+    int fd = -1;
+    int classes = 0;
+    FeatureExtractor features;
+    std::vector<std::uint64_t> starts;    // Offset de chaque ligne valide
+    std::vector<std::uint32_t> lengths;   // Sans le '\n'
+    std::vector<std::uint8_t> labels;
+};
+
+} // namespace analyzer
@@ -1,14 +1,47 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
 #include <utility>
+#include "FeatureExtractor.hpp"
+#include "Types.hpp"
 
 namespace analyzer {
 
+// Échantillon creux : indices des features à 1 (voir FENParser::fenToIndices) et cible one-hot
+struct SparseSample {
+    std::vector<int> indices;
+    nn::Vector target;
+};
+
+// Les chemins de dataset acceptent un fichier, un répertoire (tous ses fichiers, récursivement)
+// ou un motif glob ("dataset/*/10_pieces.txt"). Les fichiers sont lus par ordre alphabétique.
+// Dans un répertoire, les fichiers binaires (.mtds, modèles...) sont ignorés.
 class Dataset {
 public:
+    static constexpr int CLASS_COUNT = 3;
+    static constexpr std::size_t CHUNK_BYTES = 1 << 20; // Tranche analysée par une tâche
+
     // Returns a pair of vectors: input (features) and target (label)
-    static std::vector<std::pair<std::vector<double>, std::vector<double>>> load(const std::string& path);
+    static std::vector<std::pair<nn::Vector, nn::Vector>> load(const std::string& path, int threads = 1);
+
+    // Même fichier, entrées gardées sous forme creuse (~70 indices au lieu de 838 valeurs).
+    // Les fichiers sont découpés en tranches (sur des fins de ligne) analysées par threads workers ;
+    // l'ordre des échantillons est celui des fichiers, quel que soit threads.
+    // features choisit l'encodage des entrées (838 features de base par défaut).
+    static std::vector<SparseSample> loadSparse(const std::string& path, int threads = 1,
+                                                const FeatureExtractor& features = FeatureExtractor(),
+                                                std::size_t chunkBytes = CHUNK_BYTES);
+
+    // Fichiers désignés par path, triés. Vide si rien ne correspond.
+    static std::vector<std::string> expandPaths(const std::string& path);
+
+    // Découpe une ligne "FEN;label" ou "FEN label". Renvoie false si la ligne est invalide.
+    static bool parseLine(const std::string& line, std::string& fen, nn::Vector& target);
+    // Version sans copie : fen pointe dans line, label = indice de classe
+    static bool parseLine(std::string_view line, std::string_view& fen, int& label);
+    // Classe d'un label texte, -1 si inconnu
+    static int labelIndex(std::string_view label);
 };
 
 } // namespace analyzer
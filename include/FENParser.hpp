@@ -1,12 +1,42 @@
 #pragma once
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "Types.hpp"
 
 namespace analyzer {
 
 class FENParser {
 public:
-    static std::vector<double> fenToVector(const std::string& fen);
+    // 64 cases x 13 canaux + trait + 4 roques + en passant
+    static constexpr int FEATURE_COUNT = 838;
+    // Features actives au plus : une par case + les 6 drapeaux
+    static constexpr int MAX_ACTIVE = 64 + 6;
+    // Un compteur plus long ne tient pas dans un int
+    static constexpr std::size_t MAX_COUNTER_DIGITS = 9;
+
+    // Sans allocation. Un FEN est refusé s'il n'a pas 8 rangées de 8 cases, un trait w/b,
+    // des roques "-" ou parmi KQkq, une case en passant "-" ou valide, et des compteurs valides pour
+    // parseCounter (optionnels). Le texte qui suit les deux compteurs est ignoré.
+    // Écrit les indices actifs par ordre croissant ; renvoie leur nombre, -1 si le FEN est invalide
+    // ou si indices a moins de MAX_ACTIVE places.
+    static int toIndices(std::string_view fen, std::span<int> indices);
+    // Écrit le vecteur dense (features.size() == FEATURE_COUNT) ; false si le FEN est invalide
+    static bool toFeatures(std::string_view fen, std::span<nn::Scalar> features);
+
+    // Versions allouantes historiques. Un FEN invalide donne un vecteur nul / aucun indice.
+    static nn::Vector fenToVector(const std::string& fen);
+
+    // Encodage creux : ajoute à indices les positions des features à 1, par ordre croissant
+    static bool fenToIndices(const std::string& fen, std::vector<int>& indices);
+
+    // Compteur de demi-coups ou de coups : 1 à MAX_COUNTER_DIGITS chiffres. Partagé avec Position::fromFen.
+    static bool parseCounter(std::string_view field, int& value);
+
+    // Index de la feature "piece sur square" (0 = a8 ... 63 = h1, ordre du FEN). piece = ' ' pour une case vide.
+    // Un coup se traduit en quelques features retirées/ajoutées (voir nn::Accumulator).
+    static int featureIndex(int square, char piece);
 };
 
 } // namespace analyzer
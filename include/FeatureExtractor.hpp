@@ -0,0 +1,55 @@
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include "FENParser.hpp"
+#include "Position.hpp"
+
+namespace analyzer {
+
+// Encodage d'une Position en features binaires creuses. Les 838 features de base (identiques à
+// FENParser) viennent toujours en premier ; les jeux optionnels sont ajoutés ensuite, dans
+// l'ordre des bits de Set. Chaque combinaison a une taille différente : la taille d'entrée
+// d'un modèle suffit à retrouver l'encodage (forInputSize).
+class FeatureExtractor {
+public:
+    enum Set : unsigned {
+        BASE = 0,
+        ATTACKS = 1,       // Cases attaquées par les blancs (64) puis par les noirs (64)
+        KING_ZONE = 2,     // Par roi : pièces amies puis ennemies autour de lui, en one-hot 0..8
+        PIECE_COUNTS = 4,  // Nombre de pièces de chaque type hors rois, en one-hot 0..8 (8 = 8 ou plus)
+        ALL = 7
+    };
+    static constexpr int ATTACK_FEATURES = 2 * 64;
+    static constexpr int KING_ZONE_FEATURES = 2 * 2 * 9;
+    static constexpr int PIECE_COUNT_FEATURES = 10 * 9;
+    // Majorant des features actives, tous jeux confondus
+    static constexpr int MAX_ACTIVE = FENParser::MAX_ACTIVE + ATTACK_FEATURES + 4 + 10;
+
+    explicit FeatureExtractor(unsigned sets = BASE);
+
+    // "base", ou une liste séparée par des virgules parmi attacks, king_zone, piece_counts
+    // (ex. "attacks,piece_counts"). Lève std::runtime_error sur un nom inconnu.
+    static FeatureExtractor parse(std::string_view spec);
+    // Encodage dont featureCount() vaut size ; false si aucun ne correspond
+    static bool forInputSize(int size, FeatureExtractor& extractor);
+
+    unsigned sets() const { return enabled; }
+    int featureCount() const { return count; }
+    std::string name() const;
+
+    // Sans allocation : écrit les indices actifs par ordre croissant et renvoie leur nombre,
+    // -1 si indices a moins de MAX_ACTIVE places
+    int extract(const Position& position, std::span<int> indices) const;
+    // Depuis un FEN : -1 s'il est invalide. Sans jeu optionnel, passe directement par FENParser.
+    int extract(std::string_view fen, std::span<int> indices) const;
+
+    // Cases attaquées par un camp (attaques pseudo-légales, clouages ignorés)
+    static std::uint64_t attacks(const Position& position, bool white);
+
+private:
+    unsigned enabled;
+    int count;
+};
+
+} // namespace analyzer
@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace nn::kernels {
+
+// Jeux d'instructions supportés, du plus portable au plus large
+enum class Isa {
+    SCALAR,
+    AVX2,
+    AVX512,
+    AVX512VNNI   // Noyaux entiers seulement (vpdpbusd)
+};
+
+// Noyaux denses utilisés par Layer. Les pointeurs x[4] désignent 4 lignes distinctes.
+// Disponibles pour float et double.
+template <typename T>
+struct KernelTable {
+    Isa isa;
+    const char* name;
+    T (*dot)(const T* a, const T* b, int n);
+    void (*dot4)(const T* w, const T* const x[4], int n, T out[4]);   // out[k] = w . x[k]
+    void (*axpy)(T a, const T* x, T* y, int n);                        // y += a * x
+    void (*axpy4)(const T a[4], const T* const x[4], T* y, int n);     // y += sum a[k] * x[k]
+    void (*axpy2)(T a, const T* x, T* y, const T* u, T* v, int n);    // y += a * x et v += a * u en une passe
+    void (*sigmoid)(const T* z, T* out, int n);                        // out = 1 / (1 + exp(-z)), exp de fastExp ; z et out peuvent coïncider
+    void (*relu)(const T* z, T* out, int n);                           // out = max(z, 0), idem
+};
+
+// Constantes de fastExp : x = n ln2 + r avec |r| <= ln2 / 2, exp(r) par Taylor de degré DEGREE, 2^n
+// écrit directement dans l'exposant. x est borné à [LO, HI] : ni infini ni dénormal en sortie.
+// Erreur relative < 1e-15 en double, < 5e-7 en float (voir test_kernels.cpp).
+template <typename T>
+struct ExpApprox;
+
+template <>
+struct ExpApprox<double> {
+    using Bits = std::uint64_t;
+    static constexpr int DEGREE = 12;
+    static constexpr int MANTISSA = 52;
+    static constexpr int BIAS = 1023;
+    static constexpr double LO = -708.0, HI = 708.0;
+    static constexpr double LN2_HI = 0x1.62e42fee00000p-1;   // Bits de poids faible nuls : n * LN2_HI exact
+    static constexpr double LN2_LO = 0x1.a39ef35793c76p-33;
+};
+
+template <>
+struct ExpApprox<float> {
+    using Bits = std::uint32_t;
+    static constexpr int DEGREE = 6;
+    static constexpr int MANTISSA = 23;
+    static constexpr int BIAS = 127;
+    static constexpr float LO = -87.0f, HI = 88.0f;
+    static constexpr float LN2_HI = 0x1.62e400p-1f;
+    static constexpr float LN2_LO = 0x1.7f7d1cp-20f;
+};
+
+template <typename T>
+struct ExpCoefficients {
+    using Bits = typename ExpApprox<T>::Bits;
+    static constexpr T LOG2E = T(1.4426950408889634);
+    // x + ROUND - ROUND arrondit x à l'entier le plus proche (|x| < 2^(MANTISSA - 1))
+    static constexpr T ROUND = T(3) * T(Bits(1) << (ExpApprox<T>::MANTISSA - 1));
+    // 1 / k!, pour le schéma de Horner
+    static constexpr std::array<T, ExpApprox<T>::DEGREE + 1> TAYLOR = [] {
+        std::array<T, ExpApprox<T>::DEGREE + 1> c{};
+        double factorial = 1.0;
+        for (int k = 0; k < static_cast<int>(c.size()); ++k) {
+            if (k > 0) factorial *= k;
+            c[k] = static_cast<T>(1.0 / factorial);
+        }
+        return c;
+    }();
+};
+
+// 2^n pour n entier dans l'intervalle de ExpApprox : ROUND + BIAS + n a n + BIAS dans ses bits de poids faible
+template <typename T>
+inline T pow2(T n) {
+    using E = ExpApprox<T>;
+    using C = ExpCoefficients<T>;
+    const auto bits = std::bit_cast<typename E::Bits>(n + (C::ROUND + E::BIAS));
+    return std::bit_cast<T>(static_cast<typename E::Bits>(bits << E::MANTISSA));
+}
+
+// exp(x) sans branche ni appel à libm ; version scalaire de référence du noyau sigmoid
+template <typename T>
+inline T fastExp(T x) {
+    using E = ExpApprox<T>;
+    using C = ExpCoefficients<T>;
+    x = std::min(std::max(x, E::LO), E::HI);
+    const T n = (x * C::LOG2E + C::ROUND) - C::ROUND;
+    const T r = (x - n * E::LN2_HI) - n * E::LN2_LO;
+    T p = C::TAYLOR[E::DEGREE];
+    for (int k = E::DEGREE - 1; k >= 0; --k) p = p * r + C::TAYLOR[k];
+    return p * pow2(n);
+}
+
+// Table choisie une seule fois au démarrage selon CPUID (MYTORCH_ISA=scalar|avx2|avx512 pour forcer)
+template <typename T>
+const KernelTable<T>& active();
+
+// Table d'un jeu d'instructions donné, nullptr si le CPU ne le supporte pas
+template <typename T>
+const KernelTable<T>* forIsa(Isa isa);
+
+// Noyaux entiers du moteur int8 (voir QuantizedNetwork). Les activations a sont dans [0, 127] :
+// pmaddubsw ne sature jamais et tous les jeux d'instructions donnent exactement le même résultat.
+// n est un multiple de 64 (lignes paddées avec des poids nuls).
+struct Int8KernelTable {
+    Isa isa;
+    const char* name;
+    std::int32_t (*dot)(const std::uint8_t* a, const std::int8_t* w, int n);
+    void (*dot4)(const std::uint8_t* a, const std::int8_t* const w[4], int n, std::int32_t out[4]); // 4 lignes de poids
+    void (*addColumn)(const std::int8_t* column, std::int32_t* acc, int n);                        // acc += column
+};
+
+// VNNI, puis AVX-512BW et AVX2 (pmaddubsw), sinon scalaire ; MYTORCH_ISA=vnni|avx512|avx2|scalar pour forcer
+const Int8KernelTable& activeInt8();
+const Int8KernelTable* int8ForIsa(Isa isa);
+
+} // namespace nn::kernels
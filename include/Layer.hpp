@@ -2,47 +2,145 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include "Activations.hpp"
+#include "Matrix.hpp"
+#include "SparseBatch.hpp"
 
 namespace nn {
 
+class Optimizer;
+
 enum class ActivationType {
     SIGMOID,
     RELU,
     SOFTMAX
 };
 
+// Appelle f avec la politique d'activation de type (voir activation:: dans Activations.hpp) :
+// seul branchement sur le type, à faire hors des boucles par échantillon et par neurone.
+template <typename F>
+void withActivation(ActivationType type, F&& f) {
+    switch (type) {
+        case ActivationType::RELU: f(activation::Relu{}); break;
+        case ActivationType::SOFTMAX: f(activation::Softmax{}); break;
+        default: f(activation::Sigmoid{}); break;
+    }
+}
+
+// État d'un forward/backward par batch. Un par thread : Layer reste const et réentrant.
+struct LayerCache {
+    const Matrix* input = nullptr;            // X (non possédé, doit survivre jusqu'au backward)
+    const SparseBatch* sparse_input = nullptr; // X creux (première couche), exclusif avec input
+    Matrix output;                            // Y = f(XW^T + B), calculé en place : Z n'est pas gardé
+    Matrix deltas;                            // dZ
+    Matrix grad_input;
+};
+
+// Accumulateurs de gradients d'une couche
+struct LayerGradients {
+    Matrix grad_weights_sum;                  // Même disposition que les poids (voir Layer::hasSparseInput)
+    std::vector<Scalar> grad_biases_sum;
+
+    void clear();
+    void add(const LayerGradients& other, int part, int parts); // Tranche part/parts des lignes
+};
+
+// Les poids sont rangés [output][input], sauf pour une couche à entrée creuse (sparseInput, la
+// première d'un Network) : [input][output], une feature active étant alors une ligne contiguë.
+// Gradients et état d'optimiseur suivent la disposition des poids : pas de copie à synchroniser.
 class Layer {
 public:
-    Layer(int inputSize, int outputSize, ActivationType activationType = ActivationType::SIGMOID);
+    Layer(int inputSize, int outputSize, ActivationType activationType = ActivationType::SIGMOID,
+          bool sparseInput = false);
+    // Poids déjà connus (chargement), dans la disposition de sparseInput : weights peut être une
+    // vue sur un fichier mappé
+    Layer(Matrix weights, std::vector<Scalar> biases, ActivationType activationType, bool sparseInput = false);
     ~Layer() = default;
+    Layer(const Layer&) = default;
+    Layer& operator=(const Layer&) = default;
+    Layer(Layer&&) noexcept = default;             // Garde les vues sur un fichier mappé
+    Layer& operator=(Layer&&) noexcept = default;
+
+    std::vector<Scalar> forward(const std::vector<Scalar>& input);
 
-    std::vector<double> forward(const std::vector<double>& input);
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output, double learningRate); // Legacy compatible
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output); // Just gradients
+    void accumulateGradients(const std::vector<Scalar>& grad_output);
+    // Backward fusionné d'un échantillon : dZ calculé une fois, puis une seule passe par ligne sur W
+    // et dW (gradients accumulés et grad_input ensemble). grad_input == nullptr : dX non calculé
+    // (première couche). grad_input a inputSize places.
+    void backwardFused(const Scalar* grad_output, Scalar* grad_input);
+
+    // Mini-batch : une ligne par échantillon (batch_size x features)
+    Matrix forwardBatch(const Matrix& input);
+    // Accumule les gradients et renvoie grad_input (vide si inputGradient est faux : première couche)
+    Matrix backwardBatch(const Matrix& grad_output, bool inputGradient = true);
+
+    // Entrée binaire creuse : Z = somme des colonnes actives de W, dW ne touche que ces colonnes.
+    // Le backward ne calcule pas grad_input (l'entrée n'est pas différentiable). Lève
+    // std::invalid_argument si la couche n'est pas sparseInput ou si input.cols() != inputSize.
+    Matrix forwardBatch(const SparseBatch& input);
+    const Matrix& forwardBatch(const SparseBatch& input, LayerCache& cache) const;
+
+    // Versions réentrantes : l'état vit dans cache/grads fournis par l'appelant
+    const Matrix& forwardBatch(const Matrix& input, LayerCache& cache) const;
+    const Matrix& backwardBatch(const Matrix& grad_output, LayerCache& cache, LayerGradients& grads,
+                                bool inputGradient = true) const;
+    LayerGradients makeGradients() const;
 
-    std::vector<double> backward(const std::vector<double>& grad_output, double learningRate); // Legacy compatible
-    std::vector<double> backward(const std::vector<double>& grad_output); // Just gradients
-    void accumulateGradients(const std::vector<double>& grad_output);
     void updateWeights(double learningRate, int batchSize);
+    void applyGradients(const LayerGradients& grads, double learningRate, int batchSize);
+    // Mise à jour par optimizer (état de la couche à l'entrée index, de la disposition des poids).
+    // SGD sans weight_decay garde la mise à jour en place ci-dessus.
+    void applyGradients(const LayerGradients& grads, double learningRate, int batchSize,
+                        Optimizer& optimizer, std::size_t index);
     void clearGradients();
 
-    void save(std::ofstream& file) const;
-    void loadWeights(std::ifstream& file);
+    void loadWeights(std::ifstream& file);   // Ancien format texte
 
     int getInputSize() const { return inputSize; }
     int getOutputSize() const { return outputSize; }
+    ActivationType getActivationType() const { return activationType; }
+    bool hasSparseInput() const { return sparseInput; }
+    // Stockage des poids, [output][input] ou [input][output] selon hasSparseInput()
+    const Matrix& getWeights() const { return weights; }
+    Scalar weight(int i, int j) const { return sparseInput ? weights(j, i) : weights(i, j); } // W[i][j]
+    // Passe à la disposition [input][output] (copie transposée) ; sans effet si déjà fait
+    void enableSparseInput();
+
+    // Accès en lecture pour les évaluations incrémentales (voir Accumulator), couche sparseInput
+    std::span<const Scalar> column(int j) const { return weights.row(j); } // Colonne j de W, contiguë
+    const std::vector<Scalar>& getBiases() const { return biases; }
+    void activate(const Scalar* z, Scalar* out) const;                       // z et out peuvent coïncider
+
+    // Forward d'un seul échantillon sans état ni allocation (const, réentrant)
+    void infer(const Scalar* input, Scalar* output) const;
+    // Entrée binaire creuse ; lève std::out_of_range pour un indice hors de [0, inputSize)
+    void infer(std::span<const int> active, Scalar* output) const;
 
 private:
     int inputSize;
     int outputSize;
     ActivationType activationType;
+    bool sparseInput;
+
+    Matrix weights;                           // [output][input], ou [input][output] si sparseInput
+    std::vector<Scalar> biases;               // Vecteur [output]
+
+    std::vector<Scalar> last_input;           // X
+    std::vector<Scalar> last_output;          // Y = f(WX + B), d'où sont tirées les dérivées
+    std::vector<Scalar> last_deltas;          // dZ du dernier backwardFused
+    LayerGradients gradients;                 // Alloué au premier usage (inutile en inférence)
 
-    std::vector<std::vector<double>> weights; // Matrice [output][input]
-    std::vector<double> biases;               // Vecteur [output]
+    Matrix batch_input;                       // Copie de X pour forwardBatch(input)
+    SparseBatch batch_sparse_input;
+    LayerCache batch_cache;
 
-    std::vector<double> last_input;           // X
-    std::vector<double> last_output;
-    std::vector<double> last_pre_activation;
-    std::vector<std::vector<double>> grad_weights_sum;
-    std::vector<double> grad_biases_sum;  // Z = WX + B
+    Scalar& at(int i, int j) { return sparseInput ? weights(j, i) : weights(i, j); }  // W[i][j]
+    void requireSparseInput(int features) const;
+    void ensureGradients();
+    void activateRows(Matrix& z) const;       // En place, une ligne par échantillon
+    void computeDeltas(const Scalar* grad_output, const Scalar* y, Scalar* dZ) const;
 };
 
-} // namespace nn
\ No newline at end of file
+} // namespace nn
@@ -5,10 +5,11 @@
 #include <vector>
 #include <cmath>
 #include <numeric>
+#include "Types.hpp"
 
 namespace nn::loss {
 
-    using Vector = std::vector<double>;
+    using Vector = nn::Vector;
 
     double meanSquaredError(const Vector& predicted, const Vector& expected);
     Vector meanSquaredErrorDerivative(const Vector& predicted, const Vector& expected);
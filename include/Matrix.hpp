@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+#include "Types.hpp"
+
+namespace nn {
+
+// Allocateur aligné (64 octets = une ligne de cache) pour le stockage des matrices
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+};
+
+// Matrice dense row-major stockée dans un seul bloc contigu.
+// Chaque ligne est alignée sur 64 octets : stride() >= cols().
+// Une matrice peut aussi être une vue sur un bloc externe (fichier mappé) : elle ne le possède
+// pas, et resize() la rend propriétaire d'un nouveau stockage. Copier une vue copie les données.
+class Matrix {
+public:
+    static constexpr int ALIGNMENT = 64;
+
+    Matrix() = default;
+    Matrix(int rows, int cols, Scalar value = 0);
+    Matrix(const Matrix& other);
+    Matrix& operator=(const Matrix& other);
+    Matrix(Matrix&&) noexcept = default;
+    Matrix& operator=(Matrix&&) noexcept = default;
+
+    // Stride (en éléments) qu'utilise le stockage propre pour cols colonnes
+    static int strideFor(int cols);
+    // Vue sur data (aligné sur 64 octets, stride == strideFor(cols), padding à zéro)
+    static Matrix view(Scalar* data, int rows, int cols);
+
+    void resize(int rows, int cols, Scalar value = 0);
+    void fill(Scalar value);
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    int stride() const { return rowStride; }
+    bool empty() const { return numRows == 0 || numCols == 0; }
+    bool isView() const { return external != nullptr; }
+
+    Scalar* data() { return external ? external : storage.data(); }
+    const Scalar* data() const { return external ? external : storage.data(); }
+
+    // Vues sur une ligne (sans le padding)
+    std::span<Scalar> row(int i) { return {data() + (std::size_t)i * rowStride, (std::size_t)numCols}; }
+    std::span<const Scalar> row(int i) const { return {data() + (std::size_t)i * rowStride, (std::size_t)numCols}; }
+
+    Scalar& operator()(int i, int j) { return data()[(std::size_t)i * rowStride + j]; }
+    Scalar operator()(int i, int j) const { return data()[(std::size_t)i * rowStride + j]; }
+
+private:
+    int numRows = 0;
+    int numCols = 0;
+    int rowStride = 0;
+    Scalar* external = nullptr;
+    std::vector<Scalar, AlignedAllocator<Scalar>> storage;
+};
+
+} // namespace nn
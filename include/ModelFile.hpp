@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace nn {
+
+class Network;
+
+// Format binaire des modèles (.nn) :
+//   Header | LayerRecord[layerCount] | blocs de poids et biais alignés sur 64 octets
+// Les poids sont stockés comme nn::Matrix (row-major, lignes paddées à 64 octets), dans la
+// disposition de la couche (transposée pour l'entrée creuse), pour être utilisés directement
+// depuis un fichier mappé. Le checksum (FNV-1a 64) couvre tout ce qui
+// suit le header. Valeurs en boutisme natif (little-endian sur x86).
+namespace model {
+
+constexpr char MAGIC[4] = {'M', 'T', 'N', 'N'};
+constexpr std::uint32_t VERSION = 2;            // La version 1 (sans transposed, 32 octets par couche) est lue
+constexpr std::uint64_t BLOCK_ALIGNMENT = 64;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t scalarSize;      // sizeof(float) ou sizeof(double)
+    std::uint32_t layerCount;
+    std::uint64_t fileSize;
+    std::uint64_t checksum;
+};
+
+struct LayerRecord {
+    std::int32_t inputSize;
+    std::int32_t outputSize;
+    std::int32_t activation;       // nn::ActivationType
+    std::int32_t stride;           // Éléments par ligne de poids stockée, padding compris
+    std::uint64_t weightsOffset;   // Depuis le début du fichier
+    std::uint64_t biasesOffset;
+    std::int32_t transposed;       // 1 : poids rangés [input][output] (Layer::hasSparseInput)
+    std::int32_t reserved;
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(LayerRecord) == 40, "model file layout must not change");
+
+// Vrai si le fichier commence par MAGIC (sinon : ancien format texte)
+bool isBinary(const std::string& path);
+
+// Lèvent std::runtime_error en cas d'échec. read() remplace les couches de net.
+// Si le type scalaire du fichier est celui du build, les poids sont des vues sur le fichier
+// mappé (MAP_PRIVATE : pages partagées entre processus, copie à l'écriture) ; sinon ils sont convertis.
+void write(const Network& net, const std::string& path);
+void read(const std::string& path, Network& net);
+
+} // namespace model
+
+} // namespace nn
@@ -1,29 +1,88 @@
 #pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
 #include <vector>
 #include <string>
 #include "Layer.hpp"
 
 namespace nn {
 
+// État propre à un thread d'entraînement : activations et gradients de chaque couche
+struct WorkerState {
+    std::vector<LayerCache> caches;
+    std::vector<LayerGradients> grads;
+};
+
+// Tampons de l'inférence, dimensionnés une fois d'après la topologie : une arène alignée
+// découpée en une tranche par couche (sortie de la couche i à offsets[i])
+struct InferenceWorkspace {
+    std::vector<Scalar, AlignedAllocator<Scalar>> arena;
+    std::vector<std::size_t> offsets;
+};
+
 class Network {
 public:
     Network();
     ~Network() = default;
+    Network(const Network&) = default;
+    Network& operator=(const Network&) = default;
+    Network(Network&&) noexcept = default;
+    Network& operator=(Network&&) noexcept = default;
 
     void addLayer(int inputSize, int outputSize, ActivationType type = ActivationType::SIGMOID);
+    void addLayer(Layer layer);
+
+    std::vector<Scalar> forward(const std::vector<Scalar>& input);
+
+    // Inférence sans allocation : les couches lisent et écrivent des tranches du workspace.
+    // Le résultat reste valide jusqu'au prochain appel avec le même workspace. Une entrée dense
+    // de mauvaise taille lève std::invalid_argument, un indice creux hors bornes std::out_of_range.
+    InferenceWorkspace makeWorkspace() const;
+    std::span<const Scalar> infer(std::span<const Scalar> input, InferenceWorkspace& workspace) const;
+    std::span<const Scalar> infer(std::span<const int> active, InferenceWorkspace& workspace) const; // Entrée creuse
+    // Mêmes appels avec le workspace du réseau (créé au premier appel après un changement de topologie).
+    // Non réentrants : un seul thread à la fois ; sinon un workspace par thread avec les versions const.
+    std::span<const Scalar> infer(std::span<const Scalar> input);
+    std::span<const Scalar> infer(std::span<const int> active);
 
-    std::vector<double> forward(const std::vector<double>& input);
+    void backward(const std::vector<Scalar>& outputGradient, double learningRate); // Legacy
+    void backward(const std::vector<Scalar>& outputGradient); // Just gradients
+    void accumulateGradients(const std::vector<Scalar>& outputGradient);
+
+    // Mini-batch (batch_size x features) : mêmes gradients que la somme des accumulateGradients
+    Matrix forwardBatch(const Matrix& input);
+    void backwardBatch(const Matrix& outputGradient);
+    Matrix forwardBatch(const SparseBatch& input); // Première couche en entrée creuse
+
+    // Versions réentrantes (const) pour l'entraînement data-parallel
+    WorkerState makeWorkerState() const;
+    const Matrix& forwardBatch(const Matrix& input, WorkerState& state) const;
+    const Matrix& forwardBatch(const SparseBatch& input, WorkerState& state) const;
+    void backwardBatch(const Matrix& outputGradient, WorkerState& state) const;
+    void applyGradients(const std::vector<LayerGradients>& grads, double learningRate, int batchSize);
+    void applyGradients(const std::vector<LayerGradients>& grads, double learningRate, int batchSize,
+                        Optimizer& optimizer);
 
-    void backward(const std::vector<double>& outputGradient, double learningRate); // Legacy
-    void backward(const std::vector<double>& outputGradient); // Just gradients
-    void accumulateGradients(const std::vector<double>& outputGradient);
     void updateWeights(double learningRate, int batchSize);
 
+    // Format binaire (voir ModelFile.hpp). load() accepte aussi l'ancien format texte.
     void save(const std::string& path) const;
     void load(const std::string& path);
 
+    // Garde vivant un stockage externe (fichier mappé) sur lequel pointent les couches
+    void setStorage(std::shared_ptr<void> owner) { storage = std::move(owner); }
+
+    size_t layerCount() const { return layers.size(); }
+    const Layer& layer(size_t i) const { return layers[i]; }
+
 private:
     std::vector<Layer> layers;
+    std::shared_ptr<void> storage;
+    InferenceWorkspace workspace;
+    std::vector<Scalar> backwardBuffers[2];   // grad_input alternés de accumulateGradients
+
+    InferenceWorkspace& ownWorkspace();
 };
 
 } // namespace nn
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "Matrix.hpp"
+
+namespace nn {
+
+enum class OptimizerType {
+    SGD,
+    MOMENTUM,
+    NESTEROV,
+    ADAM,
+    ADAMW
+};
+
+struct OptimizerOptions {
+    OptimizerType type = OptimizerType::SGD;
+    double momentum = 0.9;       // MOMENTUM / NESTEROV
+    double beta1 = 0.9;          // ADAM / ADAMW
+    double beta2 = 0.999;
+    double epsilon = 1e-8;
+    double weightDecay = 0.0;    // L2, découplé pour ADAMW ; jamais appliqué aux biais
+};
+
+// Règle de mise à jour des paramètres. L'état d'une couche (vitesse, moments) est rangé dans des
+// matrices de la même forme que ses poids : une seule boucle par ligne lit le gradient, met à jour
+// l'état et écrit les poids. Un optimiseur suit un réseau donné (une entrée d'état par couche).
+class Optimizer {
+public:
+    virtual ~Optimizer() = default;
+
+    // Lève std::runtime_error si le nom est inconnu (sgd, momentum, nesterov, adam, adamw)
+    static OptimizerType parseType(const std::string& name);
+    static const char* typeName(OptimizerType type);
+    static std::unique_ptr<Optimizer> create(const OptimizerOptions& options);
+
+    const OptimizerOptions& options() const { return opts; }
+    std::uint64_t steps() const { return step; }
+    // Vrai si l'optimiseur ne garde aucun buffer (sgd)
+    bool stateless() const { return stateBuffers == 0; }
+
+    // Une fois par batch, avant la mise à jour des couches
+    void beginStep() { ++step; }
+    // grad et gradBiases : sommes sur le batch, scale = 1 / taille du batch.
+    // L'état de la couche layer est créé à la première mise à jour.
+    void update(std::size_t layer, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                std::span<const Scalar> gradBiases, Scalar scale, double learningRate);
+
+    // Sauvegarde binaire de l'état (type, pas, buffers). load() vérifie le type et les formes
+    // au premier update ; lèvent std::runtime_error en cas d'échec.
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+
+protected:
+    // Buffers d'état par couche : stateCount() matrices de la forme des poids, autant de vecteurs de biais
+    struct Slot {
+        std::vector<Matrix> weights;
+        std::vector<std::vector<Scalar>> biases;
+    };
+
+    Optimizer(const OptimizerOptions& options, int stateCount) : opts(options), stateBuffers(stateCount) {}
+    virtual void updateLayer(Slot& slot, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                             std::span<const Scalar> gradBiases, Scalar scale, double learningRate) = 0;
+
+    OptimizerOptions opts;
+    std::uint64_t step = 0;
+
+private:
+    int stateBuffers;
+    std::vector<Slot> slots;
+};
+
+} // namespace nn
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace analyzer {
+
+// Position pré-encodée : canal FENParser de chaque case sur 4 bits (0xF = case absente
+// d'un FEN incomplet), bits 0-5 de flags = features 832-837 (trait, roques KQkq, en passant).
+struct PackedBoard {
+    std::uint8_t squares[32];      // Case 2k dans le quartet bas, 2k+1 dans le quartet haut
+    std::uint8_t flags;
+    std::uint8_t label;            // Indice de la classe cible
+};
+
+static_assert(sizeof(PackedBoard) == 34, "packed record layout must not change");
+
+// Dataset binaire (.mtds) : Header | PackedBoard[count], mappé en lecture seule.
+// 34 octets par position au lieu d'un vecteur de features : les features sont recalculées
+// à la volée (indices()) au remplissage de chaque batch.
+class PackedDataset {
+public:
+    static constexpr char MAGIC[4] = {'M', 'T', 'D', 'S'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t recordSize;  // sizeof(PackedBoard)
+        std::uint32_t classCount;
+        std::uint64_t count;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "dataset header layout must not change");
+
+    // Lève std::runtime_error si le fichier est absent, tronqué ou d'une autre version
+    explicit PackedDataset(const std::string& path);
+
+    // Vrai si le fichier commence par MAGIC (sinon : dataset texte "FEN;label")
+    static bool isPacked(const std::string& path);
+    // Encode un dataset texte (fichier, répertoire ou glob, voir Dataset::expandPaths) ;
+    // renvoie le nombre de positions écrites. Lève std::runtime_error.
+    static std::size_t pack(const std::string& textPath, const std::string& outputPath);
+
+    // indices : sortie de FENParser::fenToIndices ; decode() la restitue à l'identique
+    static PackedBoard encode(std::span<const int> indices, int label);
+    static void decode(const PackedBoard& board, std::vector<int>& indices);
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int classCount() const { return classes; }
+    int label(std::size_t i) const { return records[i].label; }
+    void indices(std::size_t i, std::vector<int>& out) const { decode(records[i], out); }
+
+private:
+    std::shared_ptr<void> mapping;     // Garde le fichier mappé ; copies partagées
+    const PackedBoard* records = nullptr;
+    std::size_t count = 0;
+    int classes = 0;
+};
+
+} // namespace analyzer
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include "Network.hpp"
+#include "Optimizer.hpp"
+#include "ThreadPool.hpp"
+
+namespace nn {
+
+// Entraînement data-parallel : chaque mini-batch est découpé en tranches contiguës,
+// une par thread, avec ses propres activations et gradients. Les gradients sont
+// ensuite réduits dans un ordre fixe avant la mise à jour : à graine et nombre de
+// threads identiques, le résultat est bit à bit reproductible.
+class ParallelTrainer {
+public:
+    struct BatchStats {
+        Accum loss = 0.0;    // Somme des cross-entropy du batch
+        int correct = 0;     // Nombre d'argmax corrects
+    };
+
+    // optimizer == nullptr : SGD. L'optimiseur doit survivre au trainer.
+    ParallelTrainer(Network& net, int threads, Optimizer* optimizer = nullptr);
+
+    // Forward + backward (Cross-Entropy) + mise à jour sur un batch (une ligne par échantillon)
+    BatchStats trainBatch(const Matrix& inputs, const Matrix& targets, double learningRate);
+    BatchStats trainBatch(const SparseBatch& inputs, const Matrix& targets, double learningRate);
+
+    int threads() const { return pool.size(); }
+
+private:
+    struct Shard {
+        WorkerState state;
+        Matrix inputs;
+        SparseBatch sparseInputs;
+        bool sparse = false;
+        Matrix targets;
+        Matrix grad;
+        BatchStats stats;
+    };
+
+    BatchStats runShards(int rows, double learningRate);
+    void runShard(Shard& shard);
+    void reduceGradients();
+
+    Network& net;
+    Optimizer* optimizer;
+    ThreadPool pool;
+    std::vector<Shard> shards;
+};
+
+} // namespace nn
@@ -0,0 +1,53 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace analyzer {
+
+// Position d'échecs en bitboards. Case 0 = a8 ... 63 = h1 (ordre du FEN, comme FENParser) :
+// le bit s de chaque bitboard correspond à la case s.
+class Position {
+public:
+    // Indice de bitboard = canal FENParser - 1 : PNBRQK puis pnbrqk
+    enum Piece { W_PAWN, W_KNIGHT, W_BISHOP, W_ROOK, W_QUEEN, W_KING,
+                 B_PAWN, B_KNIGHT, B_BISHOP, B_ROOK, B_QUEEN, B_KING, PIECE_COUNT };
+    // Bits de castling()
+    enum Castling : std::uint8_t { WHITE_KINGSIDE = 1, WHITE_QUEENSIDE = 2, BLACK_KINGSIDE = 4, BLACK_QUEENSIDE = 8 };
+
+    // Mêmes règles de validité que FENParser::toIndices ; false si le FEN est invalide
+    static bool fromFen(std::string_view fen, Position& position);
+    // Depuis les features de base (sortie de FENParser::toIndices) : la case en passant exacte
+    // et les compteurs ne sont pas dans les features (case inconnue, compteurs à 0 et 1)
+    static bool fromFeatures(std::span<const int> indices, Position& position);
+    std::string toFen() const;
+
+    std::uint64_t pieces(int piece) const { return boards[piece]; }
+    std::uint64_t white() const;
+    std::uint64_t black() const;
+    std::uint64_t occupancy() const { return white() | black(); }
+    // Canal FENParser de la case (0 = vide)
+    int channelAt(int square) const;
+
+    bool whiteToMove() const { return sideToMove; }
+    std::uint8_t castling() const { return castlingRights; }
+    bool hasEnPassant() const { return enPassant >= 0; }
+    int enPassantSquare() const { return enPassant; } // -1 : aucune ; 64 : présente mais inconnue
+
+    // Clé canonique (pièces, trait, roques, en passant ; sans les compteurs) pour cache et dédoublonnage
+    std::uint64_t key() const;
+    // Même position au sens de key() : les compteurs sont ignorés
+    bool operator==(const Position& other) const;
+
+private:
+    std::array<std::uint64_t, PIECE_COUNT> boards{};
+    bool sideToMove = true;
+    std::uint8_t castlingRights = 0;
+    std::int8_t enPassant = -1;
+    int halfmoveClock = 0;
+    int fullmoveNumber = 1;
+};
+
+} // namespace analyzer
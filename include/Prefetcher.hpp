@@ -0,0 +1,50 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "DataSource.hpp"
+
+namespace analyzer {
+
+// Parcourt les échantillons rows d'une source (dans cet ordre) par minibatches. Un thread encode
+// les batches suivants dans un anneau de depth emplacements pendant que l'appelant entraîne sur le
+// courant. rows doit survivre au Prefetcher.
+class Prefetcher {
+public:
+    Prefetcher(const DataSource& source, std::span<const std::size_t> rows, std::size_t batchSize, int depth = 2);
+    // Échantillons [begin, end) dans l'ordre
+    Prefetcher(const DataSource& source, std::size_t begin, std::size_t end, std::size_t batchSize, int depth = 2);
+    ~Prefetcher();
+    Prefetcher(const Prefetcher&) = delete;
+    Prefetcher& operator=(const Prefetcher&) = delete;
+
+    // Batch suivant, nullptr à la fin. Le batch rendu précédemment est recyclé : ne plus l'utiliser.
+    // Relance ici une exception levée par la source.
+    const Minibatch* next();
+
+private:
+    void produce();
+
+    const DataSource& source;
+    std::vector<std::size_t> range;       // Indices de [begin, end) pour le second constructeur
+    std::span<const std::size_t> rows;
+    std::size_t batchSize;
+    std::size_t batchCount;
+
+    std::vector<Minibatch> slots;
+    std::size_t produced = 0;             // Batches prêts
+    std::size_t taken = 0;                // Batches rendus à l'appelant
+    std::size_t released = 0;             // Batches dont l'emplacement est libre
+    bool stopping = false;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable freed;
+    std::thread worker;
+};
+
+} // namespace analyzer
@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Trace.hpp"
+
+namespace nn::profile {
+
+// Temps cumulés par phase et par couche, pour les colonnes de profile=1 de train. Les compteurs
+// sont atomiques : les workers de ParallelTrainer y ajoutent leur temps, qui est donc sommé sur
+// les threads. Désactivé par défaut (un test de booléen par section) ; compilé hors du binaire
+// avec make PROFILE=0 (-DMYTORCH_NO_PROFILE).
+enum Phase {
+    FORWARD,
+    BACKWARD,
+    UPDATE,
+    PHASE_COUNT
+};
+
+constexpr int MAX_LAYERS = 16;   // Couches au-delà : non chronométrées
+
+#ifdef MYTORCH_NO_PROFILE
+constexpr bool AVAILABLE = false;
+#else
+constexpr bool AVAILABLE = true;
+#endif
+
+inline std::atomic<bool> active{false};
+inline std::atomic<std::uint64_t> totals[PHASE_COUNT][MAX_LAYERS];
+
+inline bool enabled() {
+    return AVAILABLE && active.load(std::memory_order_relaxed);
+}
+
+inline std::uint64_t now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline const char* phaseName(Phase phase) {
+    return phase == FORWARD ? "forward" : phase == BACKWARD ? "backward" : "update";
+}
+
+// Ajoute à (phase, layer) le temps écoulé entre construction et destruction. Sous --trace, c'est
+// aussi un span ; forward et backward (les noyaux denses) y portent les compteurs matériels.
+class ScopedTimer {
+public:
+    ScopedTimer(Phase phase, std::size_t layer)
+        : span(phaseName(phase), static_cast<int>(layer), phase != UPDATE),
+          phase(phase), layer(layer), start(enabled() && layer < MAX_LAYERS ? now() : 0) {}
+    ~ScopedTimer() {
+        if (start) totals[phase][layer].fetch_add(now() - start, std::memory_order_relaxed);
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    trace::Span span;
+    Phase phase;
+    std::size_t layer;
+    std::uint64_t start;
+};
+
+void setEnabled(bool on);
+void reset();                                           // Remet les compteurs à zéro (début d'époque)
+double seconds(Phase phase, std::size_t layer);
+std::size_t peakRssBytes();                             // Pic de mémoire résidente du processus
+
+} // namespace nn::profile
+
+#define MYTORCH_PROFILE_CONCAT_(a, b) a##b
+#define MYTORCH_PROFILE_CONCAT(a, b) MYTORCH_PROFILE_CONCAT_(a, b)
+#ifdef MYTORCH_NO_PROFILE
+#define MYTORCH_PROFILE_SCOPE(phase, layer) ((void)0)
+#else
+#define MYTORCH_PROFILE_SCOPE(phase, layer) \
+    ::nn::profile::ScopedTimer MYTORCH_PROFILE_CONCAT(profileTimer_, __LINE__)(phase, layer)
+#endif
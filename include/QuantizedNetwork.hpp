@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "Layer.hpp"
+#include "Matrix.hpp"
+#include "SparseBatch.hpp"
+
+namespace nn {
+
+class Network;
+
+// Moteur d'inférence int8 obtenu par quantification après entraînement d'un Network.
+// Poids int8 symétriques (échelle par couche ou par neurone de sortie), activations uint8 dans
+// [0, ACTIVATION_MAX] avec une échelle par couche calibrée sur des données, accumulation int32.
+// La première couche reçoit l'entrée binaire creuse : elle somme des colonnes int8. Chaque couche
+// déquantifie son accumulateur, applique son activation puis requantifie pour la suivante ; la
+// dernière rend des probabilités en Scalar.
+//
+// Format .qnn : Header | par couche : LayerRecord, poids int8 (lignes paddées), échelles float, biais int32.
+class QuantizedNetwork {
+public:
+    enum class Granularity {
+        LAYER,      // Une échelle de poids par couche
+        CHANNEL     // Une échelle par neurone de sortie
+    };
+
+    static constexpr char MAGIC[4] = {'M', 'T', 'Q', '8'};
+    static constexpr std::uint32_t VERSION = 1;
+    // 7 bits : les paires u8 x i8 de pmaddubsw tiennent dans un int16 sans saturer
+    static constexpr int ACTIVATION_MAX = 127;
+    static constexpr int WEIGHT_MAX = 127;
+
+    // Les lignes de calibration traversent le réseau float pour fixer l'échelle des activations
+    // de chaque couche cachée. Lève std::invalid_argument si le réseau est vide.
+    static QuantizedNetwork quantize(const Network& net, const SparseBatch& calibration, Granularity granularity);
+
+    // Vrai si le fichier commence par MAGIC
+    static bool isQuantized(const std::string& path);
+    // Lèvent std::runtime_error en cas d'échec
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+
+    // Forward d'une entrée binaire creuse. Sans allocation ; non réentrant (tampons internes).
+    // Lève std::out_of_range pour un indice hors de [0, inputSize()).
+    std::span<const Scalar> infer(std::span<const int> active);
+
+    std::size_t layerCount() const { return layers.size(); }
+    int inputSize() const { return layers.empty() ? 0 : layers.front().inputSize; }
+    int outputSize() const { return layers.empty() ? 0 : layers.back().outputSize; }
+    Granularity granularity() const { return mode; }
+    // Poids, échelles et biais en mémoire
+    std::size_t parameterBytes() const;
+
+private:
+    struct QLayer {
+        int inputSize = 0;
+        int outputSize = 0;
+        ActivationType activation = ActivationType::RELU;
+        int stride = 0;                  // Octets par ligne de poids (multiple de 64)
+        float outputScale = 1.0f;        // Valeur réelle d'un pas d'activation en sortie (couches cachées)
+        // Première couche : colonnes [input][stride], sinon lignes [output][stride]
+        std::vector<std::int8_t, AlignedAllocator<std::int8_t>> weights;
+        std::vector<float> scales;       // Accumulateur -> valeur réelle, par neurone de sortie
+        std::vector<std::int32_t> biases; // Dans l'unité de l'accumulateur
+    };
+
+    void allocateBuffers();
+
+    std::vector<QLayer> layers;
+    Granularity mode = Granularity::CHANNEL;
+
+    std::vector<std::int32_t> accumulators;
+    std::vector<std::uint8_t, AlignedAllocator<std::uint8_t>> activations[2];
+    std::vector<Scalar> values;
+};
+
+} // namespace nn
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "FeatureExtractor.hpp"
+#include "Network.hpp"
+#include "QuantizedNetwork.hpp"
+
+namespace analyzer {
+
+// Serveur d'inférence persistant. Protocole ligne à ligne : le client envoie une FEN par ligne,
+// le serveur répond "label,p0,p1,p2" par ligne ("Invalid" si le FEN est refusé), dans l'ordre des requêtes
+// de la connexion.
+// Un thread d'E/S (poll) lit les requêtes de toutes les connexions ; un thread de batch les
+// regroupe (jusqu'à maxBatch, au plus maxWaitMicros après la plus ancienne) avant le forward.
+// Un modèle int8 (QuantizedNetwork) est servi par le même thread de batch, position par position.
+// Le batch part aussi dès que toutes les connexions ouvertes attendent une réponse : aucune
+// autre requête ne peut arriver, attendre ne ferait qu'ajouter de la latence.
+// Les sockets clients sont non bloquants : le thread de batch n'envoie que ce qui passe sans
+// attendre, le reste est mis en file sur la connexion et vidé par le thread d'E/S (POLLOUT). Un
+// client qui ne lit plus ses réponses ne ralentit donc que lui-même : au-delà de MAX_PENDING_OUTPUT
+// en attente, ses requêtes ne sont plus lues.
+class Server {
+public:
+    static constexpr size_t MAX_LINE_BYTES = 4096;          // Au-delà sans '\n' : connexion coupée
+    static constexpr size_t MAX_PENDING_OUTPUT = 64 * 1024;  // Au-delà : lecture suspendue
+
+    struct Options {
+        std::string socketPath;      // Socket Unix ; sinon TCP sur 127.0.0.1:port
+        int port = 0;
+        int maxBatch = 64;
+        int maxWaitMicros = 500;
+    };
+
+    // Lèvent std::runtime_error si la taille d'entrée du modèle ne correspond à aucun jeu de features
+    Server(nn::Network& net, const Options& options);
+    Server(nn::QuantizedNetwork& quantized, const Options& options);
+    ~Server();
+
+    // Ouvre le socket d'écoute puis sert jusqu'à stop(). Lève std::runtime_error si l'écoute échoue.
+    void run();
+    // Utilisable depuis un gestionnaire de signal
+    void stop();
+    bool isListening() const { return listening.load(); }
+
+    // Connexion cliente (utilisée par le générateur de charge et les tests)
+    static int connectTo(const Options& options);
+
+private:
+    struct Connection {
+        int fd;
+        std::string buffer;              // Ligne en cours de réception (thread d'E/S)
+        std::atomic<bool> reading{true}; // Faux après fin de flux ou erreur : plus de requête possible
+        int inFlight = 0;                // Requêtes sans réponse (protégé par mutex)
+        std::mutex writeMutex;
+        std::string output;              // Réponses pas encore envoyées (protégé par writeMutex)
+        bool broken = false;             // Envoi impossible, réponses abandonnées (protégé par writeMutex)
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection();
+        // Envoie sans bloquer ce qui peut l'être ; appelé sous writeMutex
+        void flush();
+    };
+    struct Request {
+        std::shared_ptr<Connection> connection;
+        std::string fen;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    Server(nn::Network* net, nn::QuantizedNetwork* quantized, int inputSize, const Options& options);
+    int openListener();
+    void ioLoop();
+    void batchLoop();
+    bool readFrom(const std::shared_ptr<Connection>& connection);
+    void closeInput(Connection& connection);
+    bool finished(Connection& connection);
+    void wake();
+
+    nn::Network* net;                    // Un seul des deux modèles est utilisé
+    nn::QuantizedNetwork* quantized;     // Non réentrant : seul le thread de batch l'appelle
+    Options options;
+    FeatureExtractor features;           // Déduit de la taille d'entrée du modèle
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1};           // Pipe pour réveiller poll() : arrêt ou réponses en attente
+    std::atomic<bool> running{false};
+    std::atomic<bool> listening{false};
+
+    std::mutex mutex;
+    std::condition_variable pending;
+    std::deque<Request> queue;
+    size_t openConnections = 0;
+    size_t busyConnections = 0;          // Connexions avec au moins une requête sans réponse
+};
+
+} // namespace analyzer
@@ -0,0 +1,36 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "Matrix.hpp"
+
+namespace nn {
+
+// Batch d'entrées binaires creuses au format CSR : pour chaque échantillon,
+// la liste des indices des features à 1 (toutes les autres valent 0).
+class SparseBatch {
+public:
+    SparseBatch() = default;
+    explicit SparseBatch(int cols);
+
+    void clear(int cols);                              // Vide le batch en gardant la capacité
+    void addRow(std::span<const int> activeIndices);    // Lève std::out_of_range hors de [0, cols)
+
+    int rows() const { return static_cast<int>(offsets.size()) - 1; }
+    int cols() const { return numCols; }
+    size_t nonZeros() const { return indices.size(); }
+
+    std::span<const int> row(int i) const {
+        return {indices.data() + offsets[i], (size_t)(offsets[i + 1] - offsets[i])};
+    }
+
+    // Conversion depuis/vers une matrice dense (les valeurs non nulles sont traitées comme 1)
+    static SparseBatch fromDense(const Matrix& dense);
+    Matrix toDense() const;
+
+private:
+    int numCols = 0;
+    std::vector<int> offsets = {0};                    // Ligne i : [offsets[i], offsets[i+1])
+    std::vector<int> indices;
+};
+
+} // namespace nn
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nn {
+
+// Pool de threads persistant exécutant des boucles parallèles bloquantes.
+// Le thread appelant participe : ThreadPool(1) n'a aucun thread secondaire.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Exécute task(0..count-1) et attend la fin. La première exception est relancée ici.
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+private:
+    void workerLoop();
+    void runTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(int)>* current = nullptr;
+    int taskCount = 0;
+    std::atomic<int> nextTask{0};
+    int busyWorkers = 0;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+};
+
+} // namespace nn
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace nn::trace {
+
+// Enregistrement de spans au format Chrome trace-event (chrome://tracing, Perfetto), activé par
+// --trace. Chaque thread écrit dans son propre tampon préalloué, sans verrou ni allocation ; le
+// fichier est écrit par stop(), une fois les threads au repos. Le tampon d'un thread terminé est
+// repris par le prochain thread du même nom, qui partage alors sa ligne dans la trace. Les spans avec compteurs lisent
+// aussi cycles, instructions et défauts de cache LLC via perf_event_open quand le noyau le permet.
+inline std::atomic<bool> active{false};
+
+inline bool enabled() {
+    return active.load(std::memory_order_relaxed);
+}
+
+// Ouvre path et commence l'enregistrement. Lève std::runtime_error si le fichier ne peut pas être créé.
+void start(const std::string& path);
+// Écrit le JSON et arrête l'enregistrement ; renvoie le nombre d'événements écrits (0 si inactif)
+std::size_t stop();
+// Vrai si au moins un thread a pu ouvrir ses compteurs matériels (valable après le premier span
+// avec compteurs). Chaque thread ouvre les siens : un span sans compteurs n'a pas de champ args.
+bool countersAvailable();
+
+// Nom du thread courant dans la trace (chaîne statique). Sans effet hors trace.
+void setThreadName(const char* name);
+
+struct Event;
+
+// Span [construction, destruction) du thread courant. name doit être une chaîne statique ;
+// arg >= 0 est affiché comme numéro de couche (L1 pour 0).
+class Span {
+public:
+    explicit Span(const char* name, int arg = -1, bool counters = false) {
+        if (enabled()) begin(name, arg, counters);
+    }
+    ~Span() {
+        if (slot) end();
+    }
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    void begin(const char* name, int arg, bool counters);
+    void end();
+
+    Event* slot = nullptr;
+};
+
+} // namespace nn::trace
+
+#define MYTORCH_TRACE_CONCAT_(a, b) a##b
+#define MYTORCH_TRACE_CONCAT(a, b) MYTORCH_TRACE_CONCAT_(a, b)
+#define MYTORCH_TRACE_SCOPE(name) ::nn::trace::Span MYTORCH_TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#define MYTORCH_TRACE_COUNTERS(name) ::nn::trace::Span MYTORCH_TRACE_CONCAT(traceSpan_, __LINE__)(name, -1, true)
@@ -0,0 +1,18 @@
+#pragma once
+#include <vector>
+
+namespace nn {
+
+// Type scalaire du moteur, fixé à la compilation (make SCALAR=float)
+#ifdef MYTORCH_SCALAR_FLOAT
+using Scalar = float;
+#else
+using Scalar = double;
+#endif
+
+// Les longues sommes (loss, métriques, normalisation softmax) restent en double
+using Accum = double;
+
+using Vector = std::vector<Scalar>;
+
+} // namespace nn
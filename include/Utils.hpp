@@ -1,10 +1,13 @@
 #pragma once
+#include <cstdint>
 
 namespace nn {
 
 class Utils {
 public:
     static double randomWeight(double min, double max);
+    // Rend l'initialisation des poids reproductible (sinon graine aléatoire)
+    static void seed(std::uint64_t value);
 };
 
 } // namespace nn
@@ -33,6 +33,77 @@ def parse_training_log(log_file):
     
     return epochs, train_loss, val_loss, train_acc, val_acc
 
+def parse_profile_columns(log_file):
+    """Parse the optional profile=1 columns (empty dict if absent)"""
+    columns = {}
+    with open(log_file, 'r') as f:
+        reader = csv.DictReader(f)
+        if not reader.fieldnames or 'samples_per_sec' not in reader.fieldnames:
+            return columns
+        names = reader.fieldnames[reader.fieldnames.index('samples_per_sec'):]
+        for name in names:
+            columns[name] = []
+        for row in reader:
+            try:
+                values = [float(row[name]) for name in names]
+            except (ValueError, KeyError, TypeError):
+                continue
+            for name, value in zip(names, values):
+                columns[name].append(value)
+    return columns
+
+def plot_throughput(epochs, profile, output_path):
+    """Generate throughput and peak memory plot"""
+    fig, ax = plt.subplots(figsize=(10, 6))
+    ax.plot(epochs, profile['samples_per_sec'], label='Samples/s', marker='o', linewidth=2)
+    ax.set_xlabel('Epoch', fontsize=12)
+    ax.set_ylabel('Training samples per second', fontsize=12)
+    ax.grid(True, alpha=0.3)
+    rss = ax.twinx()
+    rss.plot(epochs, profile['peak_rss_mb'], label='Peak RSS', color='tab:red', linestyle='--', linewidth=2)
+    rss.set_ylabel('Peak RSS (MB)', fontsize=12)
+    ax.set_title('Training Throughput and Memory', fontsize=14, fontweight='bold')
+    fig.legend(loc='lower right', fontsize=11)
+    plt.tight_layout()
+    plt.savefig(output_path, dpi=300, bbox_inches='tight')
+    print(f"✓ Throughput saved to: {output_path}")
+    plt.close()
+
+def plot_time_breakdown(epochs, profile, output_path):
+    """Generate per-epoch time split (loader wait, compute, rest) and per-layer phase times"""
+    fig, (split, layers) = plt.subplots(1, 2, figsize=(14, 6))
+    load = np.array(profile['load_wait_sec'])
+    compute = np.array(profile['compute_sec'])
+    other = np.maximum(np.array(profile['epoch_sec']) - load - compute, 0)
+    split.bar(epochs, load, label='Loader wait')
+    split.bar(epochs, compute, bottom=load, label='Compute')
+    split.bar(epochs, other, bottom=load + compute, label='Validation and checkpoints')
+    split.set_xlabel('Epoch', fontsize=12)
+    split.set_ylabel('Seconds', fontsize=12)
+    split.set_title('Epoch Wall Time', fontsize=14, fontweight='bold')
+    split.legend(fontsize=10)
+
+    # Per-layer columns (fwd_lN_sec, bwd_lN_sec, upd_lN_sec), averaged over epochs
+    count = sum(1 for name in profile if name.startswith('fwd_l'))
+    if count:
+        x = np.arange(1, count + 1)
+        bottom = np.zeros(count)
+        for phase, label in (('fwd', 'Forward'), ('bwd', 'Backward'), ('upd', 'Update')):
+            values = np.array([np.mean(profile[f'{phase}_l{l}_sec']) for l in x])
+            layers.bar(x, values, bottom=bottom, label=label)
+            bottom += values
+        layers.set_xticks(x)
+        layers.set_xlabel('Layer', fontsize=12)
+        layers.set_ylabel('Seconds per epoch (summed over threads)', fontsize=12)
+        layers.set_title('Per-Layer Time', fontsize=14, fontweight='bold')
+        layers.legend(fontsize=10)
+    else:
+        layers.set_axis_off()
+    plt.tight_layout()
+    plt.savefig(output_path, dpi=300, bbox_inches='tight')
+    print(f"✓ Time breakdown saved to: {output_path}")
+    plt.close()
+
 def plot_loss_curves(epochs, train_loss, val_loss, output_path):
     """Generate loss curves plot"""
     plt.figure(figsize=(10, 6))
@@ -120,6 +191,12 @@ def main():
     # Generate plots
     plot_loss_curves(epochs, train_loss, val_loss, output_dir / "loss_curves.png")
     plot_accuracy_curves(epochs, train_acc, val_acc, output_dir / "accuracy_curves.png")
+
+    # Instrumentation columns written by train with profile=1
+    profile = parse_profile_columns(log_file)
+    if profile and len(profile['samples_per_sec']) == len(epochs):
+        plot_throughput(epochs, profile, output_dir / "throughput.png")
+        plot_time_breakdown(epochs, profile, output_dir / "time_breakdown.png")
     
     # Parse confusion matrix if provided
     if len(sys.argv) >= 3:
@@ -139,6 +216,9 @@ def main():
     print("\nGenerated files:")
     print(f"  - {output_dir}/loss_curves.png")
     print(f"  - {output_dir}/accuracy_curves.png")
+    if profile:
+        print(f"  - {output_dir}/throughput.png")
+        print(f"  - {output_dir}/time_breakdown.png")
     if len(sys.argv) >= 3:
         print(f"  - {output_dir}/confusion_matrix.png")
 
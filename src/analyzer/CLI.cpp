@@ -1,16 +1,148 @@
 #include "CLI.hpp"
 #include "Network.hpp"
+#include "ParallelTrainer.hpp"
+#include "Optimizer.hpp"
+#include "QuantizedNetwork.hpp"
+#include "Checkpoint.hpp"
 #include "FENParser.hpp"
+#include "FeatureExtractor.hpp"
 #include "Dataset.hpp"
+#include "PackedDataset.hpp"
+#include "DataSource.hpp"
+#include "Prefetcher.hpp"
 #include "Loss.hpp"
 #include "Utils.hpp"
+#include "Server.hpp"
+#include "Kernels.hpp"
+#include "Profiler.hpp"
+#include "Trace.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <filesystem>
+#include <limits>
+#include <random>
 
 namespace analyzer {
 
+namespace {
+
+int argmax(std::span<const nn::Scalar> values) {
+    int best = 0;
+    for (size_t k = 1; k < values.size(); ++k) {
+        if (values[k] > values[best]) best = static_cast<int>(k);
+    }
+    return best;
+}
+
+const char* const LABELS[] = {"Nothing", "Check", "Checkmate"};
+
+// Serveur actif, arrêté proprement par SIGINT/SIGTERM
+Server* activeServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer) activeServer->stop();
+}
+
+// Les FEN ne contiennent ni guillemets ni barres obliques inverses, mais l'entrée est libre
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, nn::Scalar value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.6g", static_cast<double>(value));
+    out.append(buffer, length);
+}
+
+// Une ligne par position : "fen,label,p0,p1,p2" ou {"fen":...,"label":...,"probabilities":[...]}
+// probs vide = FEN invalide, label "Invalid" sans probabilités
+void appendPrediction(std::string& out, const std::string& fen, std::span<const nn::Scalar> probs, bool jsonl) {
+    const int best = probs.empty() ? -1 : argmax(probs);
+    const char* label = best < 0 ? "Invalid" : best < 3 ? LABELS[best] : "Unknown";
+    if (jsonl) {
+        out += "{\"fen\":";
+        appendJsonString(out, fen);
+        out += ",\"label\":\"";
+        out += label;
+        out += "\",\"probabilities\":[";
+        for (size_t k = 0; k < probs.size(); ++k) {
+            if (k > 0) out += ',';
+            appendNumber(out, probs[k]);
+        }
+        out += "]}\n";
+    } else {
+        out += fen;
+        out += ',';
+        out += label;
+        for (nn::Scalar p : probs) {
+            out += ',';
+            appendNumber(out, p);
+        }
+        out += '\n';
+    }
+}
+
+// Encodage des entrées d'un modèle, retrouvé depuis la taille de sa première couche
+bool modelFeatures(int inputSize, FeatureExtractor& features) {
+    if (FeatureExtractor::forInputSize(inputSize, features)) return true;
+    std::cerr << "Error: Model input size " << inputSize << " matches no feature set" << std::endl;
+    return false;
+}
+
+// --trace : démarre l'enregistrement, false et message d'erreur si le fichier ne peut être créé
+bool startTrace(const std::string& path) {
+    if (path.empty()) return true;
+    try {
+        nn::trace::start(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Écrit la trace en fin de commande, quel que soit le chemin de sortie
+struct TraceWriter {
+    std::string path;
+    ~TraceWriter() {
+        if (path.empty()) return;
+        const size_t events = nn::trace::stop();
+        std::cerr << "Trace: " << events << " events written to " << path
+                  << (nn::trace::countersAvailable() ? "" : " (hardware counters unavailable)") << std::endl;
+    }
+};
+
+// Modèle int8 (voir quantize) ; false et message d'erreur en cas d'échec
+bool loadQuantized(const std::string& path, nn::QuantizedNetwork& quantized, FeatureExtractor& features) {
+    try {
+        quantized.load(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+    return modelFeatures(quantized.inputSize(), features);
+}
+
+} // namespace
+
 int CLI::run(int argc, char** argv) {
     if (argc < 2) {
         printUsage();
@@ -27,6 +159,8 @@ int CLI::run(int argc, char** argv) {
     if (mode == "train") {
         std::string datasetPath;
         std::string configPath;
+        std::string resumePath;
+        std::string tracePath;
 
         for (int i = 2; i < argc; ++i) {
             std::string arg = argv[i];
@@ -34,6 +168,10 @@ int CLI::run(int argc, char** argv) {
                 datasetPath = argv[++i];
             } else if (arg == "--config" && i + 1 < argc) {
                 configPath = argv[++i];
+            } else if (arg == "--resume" && i + 1 < argc) {
+                resumePath = argv[++i];
+            } else if (arg == "--trace" && i + 1 < argc) {
+                tracePath = argv[++i];
             }
         }
 
@@ -43,9 +181,11 @@ int CLI::run(int argc, char** argv) {
             return 84;
         }
 
+        if (!startTrace(tracePath)) return 84;
+        TraceWriter traceWriter{tracePath};
         try {
             Config config = loadConfig(configPath);
-            trainModel(datasetPath, config);
+            trainModel(datasetPath, config, resumePath);
         } catch (const std::exception& e) {
             std::cerr << "Error during training: " << e.what() << std::endl;
             return 84;
@@ -54,6 +194,10 @@ int CLI::run(int argc, char** argv) {
     } else if (mode == "predict") {
         std::string fen;
         std::string modelPath;
+        std::string inputPath;
+        std::string format = "csv";
+        std::string tracePath;
+        int batchSize = 256;
 
         for (int i = 2; i < argc; ++i) {
             std::string arg = argv[i];
@@ -61,7 +205,26 @@ int CLI::run(int argc, char** argv) {
                 fen = argv[++i];
             } else if (arg == "--model" && i + 1 < argc) {
                 modelPath = argv[++i];
+            } else if (arg == "--input" && i + 1 < argc) {
+                inputPath = argv[++i];
+            } else if (arg == "--format" && i + 1 < argc) {
+                format = argv[++i];
+            } else if (arg == "--batch" && i + 1 < argc) {
+                batchSize = std::atoi(argv[++i]);
+            } else if (arg == "--trace" && i + 1 < argc) {
+                tracePath = argv[++i];
+            }
+        }
+
+        if (!startTrace(tracePath)) return 84;
+        TraceWriter traceWriter{tracePath};
+
+        if (!inputPath.empty() && !modelPath.empty()) {
+            if (format != "csv" && format != "jsonl") {
+                std::cerr << "Error: Unknown format '" << format << "' (expected csv or jsonl)." << std::endl;
+                return 84;
             }
+            return predictStream(inputPath, modelPath, format, std::max(1, batchSize));
         }
 
         if (fen.empty() || modelPath.empty()) {
@@ -75,10 +238,34 @@ int CLI::run(int argc, char** argv) {
         std::cout << "Model: " << modelPath << std::endl;
         
         nn::Network net;
-        net.load(modelPath);
-        
-        std::vector<double> input = FENParser::fenToVector(fen);
-        std::vector<double> output = net.forward(input);
+        nn::QuantizedNetwork quantized;
+        FeatureExtractor features;
+        if (nn::QuantizedNetwork::isQuantized(modelPath)) {
+            MYTORCH_TRACE_SCOPE("load_model");
+            if (!loadQuantized(modelPath, quantized, features)) return 84;
+        } else {
+            MYTORCH_TRACE_SCOPE("load_model");
+            net.load(modelPath);
+            if (net.layerCount() == 0) {
+                std::cerr << "Error: No layers loaded from " << modelPath << std::endl;
+                return 84;
+            }
+            if (!modelFeatures(net.layer(0).getInputSize(), features)) return 84;
+        }
+
+        int indices[FeatureExtractor::MAX_ACTIVE];
+        const int count = features.extract(fen, indices);
+        if (count < 0) {
+            std::cerr << "Error: Invalid FEN: " << fen << std::endl;
+            return 84;
+        }
+        const std::span<const int> active(indices, count);
+        nn::Vector output;
+        {
+            MYTORCH_TRACE_COUNTERS("infer");
+            auto probs = quantized.layerCount() > 0 ? quantized.infer(active) : net.infer(active);
+            output.assign(probs.begin(), probs.end());
+        }
         
         std::cout << "Output: [";
         for (size_t i = 0; i < output.size(); ++i) {
@@ -97,6 +284,160 @@ int CLI::run(int argc, char** argv) {
         else result = "Checkmate";
         
         std::cout << "Prediction: " << result << std::endl;
+    } else if (mode == "serve") {
+        std::string modelPath;
+        Server::Options options;
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--model" && i + 1 < argc) {
+                modelPath = argv[++i];
+            } else if (arg == "--socket" && i + 1 < argc) {
+                options.socketPath = argv[++i];
+            } else if (arg == "--port" && i + 1 < argc) {
+                options.port = std::atoi(argv[++i]);
+            } else if (arg == "--max-batch" && i + 1 < argc) {
+                options.maxBatch = std::atoi(argv[++i]);
+            } else if (arg == "--max-wait-us" && i + 1 < argc) {
+                options.maxWaitMicros = std::atoi(argv[++i]);
+            }
+        }
+
+        if (modelPath.empty() || (options.socketPath.empty() && options.port <= 0)) {
+            std::cerr << "Error: Missing arguments for serve mode." << std::endl;
+            printUsage();
+            return 84;
+        }
+
+        // Modèle float, ou int8 (quantize)
+        nn::Network net;
+        nn::QuantizedNetwork quantized;
+        if (nn::QuantizedNetwork::isQuantized(modelPath)) {
+            FeatureExtractor features;
+            if (!loadQuantized(modelPath, quantized, features)) return 84;
+        } else {
+            net.load(modelPath);
+            if (net.layerCount() == 0) {
+                std::cerr << "Error: No layers loaded from " << modelPath << std::endl;
+                return 84;
+            }
+        }
+
+        try {
+            auto server = quantized.layerCount() > 0 ? std::make_unique<Server>(quantized, options)
+                                                     : std::make_unique<Server>(net, options);
+            activeServer = server.get();
+            std::signal(SIGINT, stopServer);
+            std::signal(SIGTERM, stopServer);
+            std::cerr << "Serving on " << (options.socketPath.empty() ? "127.0.0.1:" + std::to_string(options.port)
+                                                                      : options.socketPath)
+                      << " (max batch " << options.maxBatch << ", max wait " << options.maxWaitMicros << "us)" << std::endl;
+            server->run();
+            activeServer = nullptr;
+        } catch (const std::exception& e) {
+            activeServer = nullptr;
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 84;
+        }
+    } else if (mode == "pack") {
+        std::string inputPath;
+        std::string outputPath;
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--dataset" && i + 1 < argc) {
+                inputPath = argv[++i];
+            } else if (arg == "--output" && i + 1 < argc) {
+                outputPath = argv[++i];
+            }
+        }
+
+        if (inputPath.empty() || outputPath.empty()) {
+            std::cerr << "Error: Missing arguments for pack mode." << std::endl;
+            printUsage();
+            return 84;
+        }
+
+        try {
+            size_t count = PackedDataset::pack(inputPath, outputPath);
+            std::cerr << "Packed " << count << " positions into " << outputPath << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 84;
+        }
+    } else if (mode == "convert") {
+        std::string modelPath;
+        std::string outputPath;
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--model" && i + 1 < argc) {
+                modelPath = argv[++i];
+            } else if (arg == "--output" && i + 1 < argc) {
+                outputPath = argv[++i];
+            }
+        }
+
+        if (modelPath.empty() || outputPath.empty()) {
+            std::cerr << "Error: Missing arguments for convert mode." << std::endl;
+            printUsage();
+            return 84;
+        }
+
+        // load() lit l'ancien format texte comme le binaire, save() écrit toujours le binaire
+        nn::Network net;
+        net.load(modelPath);
+        if (net.layerCount() == 0) {
+            std::cerr << "Error: No layers loaded from " << modelPath << std::endl;
+            return 84;
+        }
+        net.save(outputPath);
+    } else if (mode == "quantize") {
+        std::string modelPath;
+        std::string datasetPath;
+        std::string outputPath;
+        std::string granularity = "channel";
+        double validationRatio = 0.2;
+        std::uint64_t seed = 0;
+        bool seedSet = false;             // Obligatoire : train tire une graine au hasard quand seed=0
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--model" && i + 1 < argc) {
+                modelPath = argv[++i];
+            } else if (arg == "--dataset" && i + 1 < argc) {
+                datasetPath = argv[++i];
+            } else if (arg == "--output" && i + 1 < argc) {
+                outputPath = argv[++i];
+            } else if (arg == "--granularity" && i + 1 < argc) {
+                granularity = argv[++i];
+            } else if (arg == "--validation-ratio" && i + 1 < argc) {
+                validationRatio = std::atof(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                seed = std::strtoull(argv[++i], nullptr, 10);
+                seedSet = true;
+            }
+        }
+
+        if (!seedSet) {
+            std::cerr << "Error: quantize needs --seed, the value printed by train (\"Seed: N\") or stored in its checkpoint,"
+                         " to calibrate and validate on the same split." << std::endl;
+            printUsage();
+            return 84;
+        }
+        if (modelPath.empty() || datasetPath.empty() || outputPath.empty() ||
+            (granularity != "channel" && granularity != "layer") || validationRatio <= 0 || validationRatio >= 1) {
+            std::cerr << "Error: Missing or invalid arguments for quantize mode." << std::endl;
+            printUsage();
+            return 84;
+        }
+
+        try {
+            return quantizeModel(modelPath, datasetPath, outputPath, granularity, validationRatio, seed);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 84;
+        }
     } else {
         std::cerr << "Error: Unknown mode '" << mode << "'" << std::endl;
         printUsage();
@@ -105,10 +446,172 @@ int CLI::run(int argc, char** argv) {
     return 0;
 }
 
+int CLI::predictStream(const std::string& inputPath, const std::string& modelPath,
+                       const std::string& format, int batchSize) {
+    // Modèle float, ou int8 (quantize) évalué position par position
+    nn::Network net;
+    nn::QuantizedNetwork quantized;
+    FeatureExtractor features;
+    if (nn::QuantizedNetwork::isQuantized(modelPath)) {
+        MYTORCH_TRACE_SCOPE("load_model");
+        if (!loadQuantized(modelPath, quantized, features)) return 84;
+    } else {
+        MYTORCH_TRACE_SCOPE("load_model");
+        net.load(modelPath);
+        if (net.layerCount() == 0) {
+            std::cerr << "Error: No layers loaded from " << modelPath << std::endl;
+            return 84;
+        }
+        if (!modelFeatures(net.layer(0).getInputSize(), features)) return 84;
+    }
+
+    std::ifstream file;
+    if (inputPath != "-") {
+        file.open(inputPath);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot open input file " << inputPath << std::endl;
+            return 84;
+        }
+    }
+    std::istream& in = (inputPath == "-") ? std::cin : file;
+
+    const bool jsonl = (format == "jsonl");
+    std::vector<std::string> fens;
+    std::vector<char> valid;
+    int indices[FeatureExtractor::MAX_ACTIVE];
+    nn::SparseBatch batch;
+    std::string line, out;
+
+    // Une sortie par batch : pas de flush par ligne
+    auto flush = [&]() {
+        if (fens.empty()) return;
+        batch.clear(features.featureCount());
+        valid.clear();
+        {
+            MYTORCH_TRACE_SCOPE("encode");
+            for (const auto& fen : fens) {
+                // Un FEN invalide garde sa ligne (vide) pour que la sortie reste alignée sur l'entrée
+                const int count = features.extract(fen, indices);
+                valid.push_back(count >= 0);
+                batch.addRow(std::span<const int>(indices, std::max(count, 0)));
+            }
+        }
+        out.clear();
+        MYTORCH_TRACE_COUNTERS("infer_batch");
+        if (quantized.layerCount() > 0) {
+            for (int b = 0; b < batch.rows(); ++b) {
+                appendPrediction(out, fens[b], valid[b] ? quantized.infer(batch.row(b)) : std::span<const nn::Scalar>(), jsonl);
+            }
+        } else {
+            nn::Matrix outputs = net.forwardBatch(batch);
+            for (int b = 0; b < outputs.rows(); ++b) {
+                appendPrediction(out, fens[b], valid[b] ? outputs.row(b) : std::span<const nn::Scalar>(), jsonl);
+            }
+        }
+        std::cout.write(out.data(), out.size());
+        fens.clear();
+    };
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        // Accepte aussi les lignes de dataset "FEN;label"
+        size_t sep = line.find(';');
+        if (sep != std::string::npos) line.resize(sep);
+        if (line.empty()) continue;
+        fens.push_back(line);
+        if ((int)fens.size() == batchSize) flush();
+    }
+    flush();
+    std::cout.flush();
+    return 0;
+}
+
 void CLI::printUsage() {
     std::cout << "Usage:" << std::endl;
-    std::cout << "  my_torch_analyzer train --dataset <path> --config <path>" << std::endl;
-    std::cout << "  my_torch_analyzer predict --fen <fen> --model <path>" << std::endl;
+    std::cout << "  my_torch_analyzer train --dataset <path> --config <path> [--resume <checkpoint>] [--trace <file.json>]" << std::endl;
+    std::cout << "  my_torch_analyzer predict --fen <fen> --model <path> [--trace <file.json>]" << std::endl;
+    std::cout << "  my_torch_analyzer predict --input <file|-> --model <path> [--format csv|jsonl] [--batch N] [--trace <file.json>]" << std::endl;
+    std::cout << "  my_torch_analyzer serve --model <path> (--socket <path> | --port <n>) [--max-batch N] [--max-wait-us N]" << std::endl;
+    std::cout << "  my_torch_analyzer pack --dataset <dataset.txt> --output <dataset.mtds>" << std::endl;
+    std::cout << "  my_torch_analyzer convert --model <legacy.nn> --output <path>" << std::endl;
+    std::cout << "  my_torch_analyzer quantize --model <model.nn> --dataset <path> --output <model.qnn>"
+                 " --seed N [--granularity channel|layer] [--validation-ratio R]" << std::endl;
+}
+
+int CLI::quantizeModel(const std::string& modelPath, const std::string& datasetPath, const std::string& outputPath,
+                       const std::string& granularity, double validationRatio, std::uint64_t seed) {
+    nn::Network net;
+    net.load(modelPath);
+    if (net.layerCount() == 0) {
+        std::cerr << "Error: No layers loaded from " << modelPath << std::endl;
+        return 84;
+    }
+    FeatureExtractor features;
+    if (!modelFeatures(net.layer(0).getInputSize(), features)) return 84;
+
+    std::unique_ptr<DataSource> data = DataSource::open(datasetPath, false, 1, features);
+    // Même graine que l'entraînement (seed= du checkpoint) : même partie validation
+    std::mt19937_64 rng(seed);
+    const Split split = stratifiedSplit(*data, validationRatio, rng);
+    if (split.train.empty() || split.validation.empty()) {
+        throw std::runtime_error("Dataset too small to calibrate and validate");
+    }
+
+    // Calibration sur un échantillon de la partie entraînement
+    constexpr size_t CALIBRATION_ROWS = 10000;
+    std::vector<size_t> calibrationRows = split.train;
+    std::shuffle(calibrationRows.begin(), calibrationRows.end(), rng);
+    calibrationRows.resize(std::min(calibrationRows.size(), CALIBRATION_ROWS));
+    Minibatch calibration;
+    data->fill(calibrationRows, calibration);
+
+    const auto mode = granularity == "layer" ? nn::QuantizedNetwork::Granularity::LAYER
+                                             : nn::QuantizedNetwork::Granularity::CHANNEL;
+    nn::QuantizedNetwork quantized = nn::QuantizedNetwork::quantize(net, calibration.inputs, mode);
+
+    // Les deux modèles prédisent position par position, chacun chronométré séparément
+    size_t floatCorrect = 0, quantizedCorrect = 0, agree = 0;
+    double floatSeconds = 0, quantizedSeconds = 0;
+    std::vector<int> floatPredictions;
+    Prefetcher batches(*data, split.validation, 1024);
+    while (const Minibatch* batch = batches.next()) {
+        const int rows = batch->inputs.rows();
+        floatPredictions.resize(rows);
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < rows; ++b) floatPredictions[b] = argmax(net.infer(batch->inputs.row(b)));
+        auto middle = std::chrono::steady_clock::now();
+        for (int b = 0; b < rows; ++b) {
+            const int prediction = argmax(quantized.infer(batch->inputs.row(b)));
+            const int truth = argmax(batch->targets.row(b));
+            quantizedCorrect += prediction == truth;
+            floatCorrect += floatPredictions[b] == truth;
+            agree += prediction == floatPredictions[b];
+        }
+        auto end = std::chrono::steady_clock::now();
+        floatSeconds += std::chrono::duration<double>(middle - start).count();
+        quantizedSeconds += std::chrono::duration<double>(end - middle).count();
+    }
+
+    size_t floatBytes = 0;
+    for (size_t l = 0; l < net.layerCount(); ++l) {
+        const nn::Layer& layer = net.layer(l);
+        floatBytes += (static_cast<size_t>(layer.getInputSize()) + 1) * layer.getOutputSize() * sizeof(nn::Scalar);
+    }
+    const double samples = static_cast<double>(split.validation.size());
+    const double floatAccuracy = 100.0 * floatCorrect / samples;
+    const double quantizedAccuracy = 100.0 * quantizedCorrect / samples;
+    std::printf("Calibrated on %zu samples, validated on %zu samples (%s scales, %s kernels)\n",
+                calibrationRows.size(), split.validation.size(), granularity.c_str(), nn::kernels::activeInt8().name);
+    std::printf("Accuracy: float %.2f%%, int8 %.2f%% (delta %+.2f points), agreement %.2f%%\n",
+                floatAccuracy, quantizedAccuracy, quantizedAccuracy - floatAccuracy, 100.0 * agree / samples);
+    std::printf("Parameters: float %zu bytes, int8 %zu bytes (%.1fx smaller)\n", floatBytes,
+                quantized.parameterBytes(), static_cast<double>(floatBytes) / quantized.parameterBytes());
+    std::printf("Throughput: float %.0f samples/s, int8 %.0f samples/s (%.1fx)\n", samples / floatSeconds,
+                samples / quantizedSeconds, floatSeconds / quantizedSeconds);
+
+    quantized.save(outputPath);
+    std::cerr << "Quantized model written to " << outputPath << std::endl;
+    return 0;
 }
 
 CLI::Config CLI::loadConfig(const std::string& path) {
@@ -130,6 +633,22 @@ CLI::Config CLI::loadConfig(const std::string& path) {
             else if (key == "validation_ratio") config.validationSplit = std::stod(value);
             else if (key == "lr_decay") config.lrDecay = std::stod(value);
             else if (key == "decay_step") config.decayStep = std::stoi(value);
+            else if (key == "threads") config.threads = std::stoi(value);
+            else if (key == "streaming") config.streaming = std::stoi(value) != 0;
+            else if (key == "features") config.features = value;
+            else if (key == "optimizer") config.optimizer = value;
+            else if (key == "momentum") config.momentum = std::stod(value);
+            else if (key == "beta1") config.beta1 = std::stod(value);
+            else if (key == "beta2") config.beta2 = std::stod(value);
+            else if (key == "weight_decay") config.weightDecay = std::stod(value);
+            else if (key == "patience") config.patience = std::stoi(value);
+            else if (key == "monitor") config.monitor = value;
+            else if (key == "min_delta") config.minDelta = std::stod(value);
+            else if (key == "checkpoint_dir") config.checkpointDir = value;
+            else if (key == "keep_checkpoints") config.keepCheckpoints = std::stoi(value);
+            else if (key == "seed") config.seed = std::stoull(value);
+            else if (key == "shuffle") config.shuffle = std::stoi(value) != 0;
+            else if (key == "profile") config.profile = std::stoi(value) != 0;
             else if (key == "layers") {
                 std::stringstream lss(value);
                 std::string segment;
@@ -142,17 +661,23 @@ CLI::Config CLI::loadConfig(const std::string& path) {
     return config;
 }
 
-void CLI::trainModel(const std::string& datasetPath, const Config& config) {
+void CLI::trainModel(const std::string& datasetPath, const Config& config, const std::string& resumePath) {
     std::cout << "Loading dataset..." << std::endl;
-    auto data = Dataset::load(datasetPath);
-    if (data.empty()) {
+    // Dataset binaire (voir "pack") mappé, sinon texte chargé en mémoire ou lu en flux (streaming=1)
+    // Jeux de features optionnels (features=attacks,king_zone,piece_counts) ajoutés aux 838 de base
+    const FeatureExtractor features = FeatureExtractor::parse(config.features);
+    if (features.sets() != FeatureExtractor::BASE) {
+        std::cout << "Features: " << features.name() << " (" << features.featureCount() << " inputs)" << std::endl;
+    }
+    std::unique_ptr<DataSource> data = DataSource::open(datasetPath, config.streaming, config.threads, features);
+    if (data->size() == 0) {
         throw std::runtime_error("Dataset is empty or failed to load");
     }
 
-    size_t valSize = static_cast<size_t>(data.size() * config.validationSplit);
-    size_t trainSize = data.size() - valSize;
-    
-    std::cout << "Training on " << trainSize << " samples, validating on " << valSize << " samples." << std::endl;
+    // Graine 0 : tirée au hasard et affichée pour pouvoir rejouer l'entraînement
+    TrainingState state;
+    state.seed = config.seed != 0 ? config.seed : std::random_device{}();
+    nn::Utils::seed(state.seed);
 
     nn::Network net;
     for (size_t i = 0; i < config.layers.size() - 1; ++i) {
@@ -160,14 +685,90 @@ void CLI::trainModel(const std::string& datasetPath, const Config& config) {
         net.addLayer(config.layers[i], config.layers[i+1], act);
     }
 
-    std::cout << "Starting training loop..." << std::endl;
-    std::cout << "epoch,train_loss,val_loss,train_acc,val_acc" << std::endl;
+    const int inputSize = config.layers.front();
+    const int outputSize = config.layers.back();
+    if (inputSize != features.featureCount() || data->classCount() != outputSize) {
+        throw std::runtime_error("Dataset dimensions do not match the configured topology");
+    }
+    const size_t batchSize = static_cast<size_t>(std::max(1, config.batchSize));
+
+    const bool monitorLoss = config.monitor == "val_loss";
+    if (!monitorLoss && config.monitor != "val_acc") {
+        throw std::runtime_error("Unknown monitor '" + config.monitor + "' (expected val_acc or val_loss)");
+    }
+
+    nn::OptimizerOptions optimizerOptions;
+    optimizerOptions.type = nn::Optimizer::parseType(config.optimizer);
+    optimizerOptions.momentum = config.momentum;
+    optimizerOptions.beta1 = config.beta1;
+    optimizerOptions.beta2 = config.beta2;
+    optimizerOptions.weightDecay = config.weightDecay;
+    std::unique_ptr<nn::Optimizer> optimizer = nn::Optimizer::create(optimizerOptions);
+    if (optimizerOptions.type != nn::OptimizerType::SGD) {
+        std::cout << "Optimizer: " << config.optimizer << std::endl;
+    }
+
+    // Précision : le meilleur part de 0 comme avant ; perte : de +infini
+    state.learningRate = config.learningRate;
+    state.monitor = config.monitor;
+    state.best = monitorLoss ? std::numeric_limits<double>::infinity() : 0.0;
+    if (!resumePath.empty()) {
+        TrainingState saved = checkpoint::read(resumePath, net, *optimizer);
+        std::vector<int> topology;
+        for (size_t i = 0; i < net.layerCount(); ++i) topology.push_back(net.layer(i).getInputSize());
+        if (net.layerCount() > 0) topology.push_back(net.layer(net.layerCount() - 1).getOutputSize());
+        if (topology != config.layers) {
+            throw std::runtime_error("Checkpoint topology does not match the configured layers");
+        }
+        // Un autre critère rend l'ancien meilleur score sans objet
+        if (saved.monitor != state.monitor) {
+            saved.monitor = state.monitor;
+            saved.best = state.best;
+            saved.staleEpochs = 0;
+        }
+        if (saved.seed == 0) saved.seed = state.seed;  // Checkpoint antérieur à la graine
+        state = saved;
+    }
+
+    // Découpage stratifié par classe, indépendant de l'ordre du fichier. À la reprise, la graine du
+    // checkpoint redonne le même ensemble de validation.
+    std::mt19937_64 splitRng(state.seed);
+    const Split split = stratifiedSplit(*data, config.validationSplit, splitRng);
+    const size_t trainSize = split.train.size();
+    const size_t valSize = split.validation.size();
+    if (trainSize == 0) throw std::runtime_error("No training samples left after the validation split");
+    std::cout << "Seed: " << state.seed << std::endl;
+    std::cout << "Training on " << trainSize << " samples, validating on " << valSize << " samples." << std::endl;
+
+    // Modèles écrits dans checkpoint_dir s'il est défini, sinon dans le répertoire courant
+    const std::string outputDir = config.checkpointDir.empty() ? "" : config.checkpointDir + "/";
+    if (!outputDir.empty()) std::filesystem::create_directories(config.checkpointDir);
 
-    double currentLr = config.learningRate;
+    nn::ParallelTrainer trainer(net, config.threads, optimizer.get());
+    if (trainer.threads() > 1) {
+        std::cout << "Using " << trainer.threads() << " training threads." << std::endl;
+    }
+
+    // profile=1 : colonnes de temps (secondes) ajoutées à la suite. Les temps par couche sont
+    // sommés sur les threads d'entraînement ; update comprend la réduction des gradients.
+    nn::profile::setEnabled(config.profile);
+    if (config.profile && !nn::profile::AVAILABLE) {
+        std::cerr << "Warning: per-layer timers are compiled out (PROFILE=0)" << std::endl;
+    }
+    std::cout << "Starting training loop..." << std::endl;
+    std::cout << "epoch,train_loss,val_loss,train_acc,val_acc";
+    if (config.profile) {
+        std::cout << ",samples_per_sec,epoch_sec,load_wait_sec,compute_sec,peak_rss_mb";
+        for (size_t l = 0; nn::profile::AVAILABLE && l < std::min<size_t>(net.layerCount(), nn::profile::MAX_LAYERS); ++l) {
+            std::cout << ",fwd_l" << l + 1 << "_sec,bwd_l" << l + 1 << "_sec,upd_l" << l + 1 << "_sec";
+        }
+    }
+    std::cout << std::endl;
 
-    double bestValAcc = 0.0; // Checkpointing
+    double& currentLr = state.learningRate;
 
-    for (int epoch = 0; epoch < config.epochs; ++epoch) {
+    for (int epoch = state.epoch; epoch < config.epochs; ++epoch) {
+        MYTORCH_TRACE_SCOPE("epoch");
         if (epoch > 0 && epoch % config.decayStep == 0) {
             currentLr *= config.lrDecay;
             std::cout << "Adjusting learning rate to " << currentLr << std::endl;
@@ -175,75 +776,124 @@ void CLI::trainModel(const std::string& datasetPath, const Config& config) {
         double totalLoss = 0.0;
         int correct = 0;
 
-        int batchCount = 0;
-        for (size_t i = 0; i < trainSize; ++i) {
-            auto& sample = data[i];
-            
-            auto output = net.forward(sample.first);
-            totalLoss += nn::loss::crossEntropy(output, sample.second);
-            
-            int predIdx = 0, truthIdx = 0;
-            for(size_t k=1; k<output.size(); ++k) if(output[k] > output[predIdx]) predIdx = k;
-            for(size_t k=1; k<sample.second.size(); ++k) if(sample.second[k] > sample.second[truthIdx]) truthIdx = k;
-            if(predIdx == truthIdx) correct++;
-
-            auto grad = nn::loss::crossEntropyDerivative(output, sample.second);
-            net.accumulateGradients(grad);
-
-            batchCount++;
-            if (batchCount >= config.batchSize || i == trainSize - 1) {
-                net.updateWeights(currentLr, batchCount);
-                batchCount = 0;
+        // Permutation de l'époque tirée de (graine, époque) : une reprise retrouve le même ordre.
+        // Seuls les indices sont mélangés, jamais les échantillons.
+        std::vector<size_t> order = split.train;
+        if (config.shuffle) {
+            std::seed_seq epochSeed{static_cast<std::uint32_t>(state.seed), static_cast<std::uint32_t>(state.seed >> 32),
+                                    static_cast<std::uint32_t>(epoch)};
+            std::mt19937_64 shuffleRng(epochSeed);
+            std::shuffle(order.begin(), order.end(), shuffleRng);
+        }
+
+        // Le batch suivant est encodé en arrière-plan pendant l'entraînement sur le courant.
+        // Le temps passé dans next() est l'attente du chargement, le reste est du calcul.
+        using Clock = std::chrono::steady_clock;
+        const auto epochStart = Clock::now();
+        double loadSeconds = 0.0, computeSeconds = 0.0;
+        nn::profile::reset();
+        Prefetcher trainBatches(*data, order, batchSize);
+        for (;;) {
+            const auto waitStart = Clock::now();
+            const Minibatch* batch;
+            {
+                MYTORCH_TRACE_SCOPE("load_wait");
+                batch = trainBatches.next();
             }
+            const auto computeStart = Clock::now();
+            loadSeconds += std::chrono::duration<double>(computeStart - waitStart).count();
+            if (!batch) break;
+            MYTORCH_TRACE_SCOPE("train_batch");
+            auto stats = trainer.trainBatch(batch->inputs, batch->targets, currentLr);
+            totalLoss += stats.loss;
+            correct += stats.correct;
+            computeSeconds += std::chrono::duration<double>(Clock::now() - computeStart).count();
         }
+        const double trainSeconds = std::chrono::duration<double>(Clock::now() - epochStart).count();
 
         double avgTrainLoss = totalLoss / trainSize;
         double trainAcc = (double)correct / trainSize;
 
         double valLoss = 0.0;
         int valCorrect = 0;
-        for (size_t i = trainSize; i < data.size(); ++i) {
-            auto& sample = data[i];
-            auto output = net.forward(sample.first);
-            valLoss += nn::loss::crossEntropy(output, sample.second);
-            
-            int predIdx = 0, truthIdx = 0;
-            for(size_t k=1; k<output.size(); ++k) if(output[k] > output[predIdx]) predIdx = k;
-            for(size_t k=1; k<sample.second.size(); ++k) if(sample.second[k] > sample.second[truthIdx]) truthIdx = k;
-            if(predIdx == truthIdx) valCorrect++;
+        {
+            MYTORCH_TRACE_SCOPE("validation");
+            Prefetcher valBatches(*data, split.validation, batchSize);
+            while (const Minibatch* batch = valBatches.next()) {
+                const nn::Matrix& targets = batch->targets;
+                nn::Matrix output = net.forwardBatch(batch->inputs);
+                for (int b = 0; b < output.rows(); ++b) {
+                    nn::loss::Vector out(output.row(b).begin(), output.row(b).end());
+                    nn::loss::Vector expected(targets.row(b).begin(), targets.row(b).end());
+                    valLoss += nn::loss::crossEntropy(out, expected);
+                    if (argmax(output.row(b)) == argmax(targets.row(b))) valCorrect++;
+                }
+            }
         }
         double avgValLoss = (valSize > 0) ? valLoss / valSize : 0.0;
         double valAcc = (valSize > 0) ? (double)valCorrect / valSize : 0.0;
 
-        std::cout << epoch + 1 << "," << avgTrainLoss << "," << avgValLoss << "," << trainAcc << "," << valAcc << std::endl;
+        std::cout << epoch + 1 << "," << avgTrainLoss << "," << avgValLoss << "," << trainAcc << "," << valAcc;
+        if (config.profile) {
+            const double epochSeconds = std::chrono::duration<double>(Clock::now() - epochStart).count();
+            std::cout << "," << trainSize / trainSeconds << "," << epochSeconds << "," << loadSeconds << ","
+                      << computeSeconds << "," << nn::profile::peakRssBytes() / (1024.0 * 1024.0);
+            for (size_t l = 0; nn::profile::AVAILABLE && l < std::min<size_t>(net.layerCount(), nn::profile::MAX_LAYERS); ++l) {
+                std::cout << "," << nn::profile::seconds(nn::profile::FORWARD, l) << ","
+                          << nn::profile::seconds(nn::profile::BACKWARD, l) << ","
+                          << nn::profile::seconds(nn::profile::UPDATE, l);
+            }
+        }
+        std::cout << std::endl;
+
+        // Meilleur modèle et early stopping sur le critère surveillé (sans validation : jamais)
+        state.epoch = epoch + 1;
+        const double metric = monitorLoss ? avgValLoss : valAcc;
+        const bool improved = valSize > 0 && (monitorLoss ? metric < state.best - config.minDelta
+                                                          : metric > state.best + config.minDelta);
+        if (improved) {
+            state.best = metric;
+            state.staleEpochs = 0;
+            MYTORCH_TRACE_SCOPE("save_best");
+            checkpoint::saveModel(net, outputDir + "my_torch_network.nn");
+        } else if (valSize > 0) {
+            state.staleEpochs++;
+        }
 
-        // Checkpointing
-        if (valAcc > bestValAcc) {
-            bestValAcc = valAcc;
-            net.save("my_torch_network.nn");
-            // std::cout << "New best model saved!" << std::endl; // Optional spam
+        if (!config.checkpointDir.empty()) {
+            MYTORCH_TRACE_SCOPE("checkpoint");
+            const std::string path = checkpoint::write(config.checkpointDir, net, *optimizer, state,
+                                                       config.keepCheckpoints);
+            std::cerr << "Checkpoint saved to " << path << std::endl;
+        }
+
+        if (config.patience > 0 && state.staleEpochs >= config.patience) {
+            std::cout << "Early stopping: no " << config.monitor << " improvement for "
+                      << state.staleEpochs << " epochs." << std::endl;
+            break;
         }
     }
-    
-    net.save("my_torch_network_final.nn");
+
+    checkpoint::saveModel(net, outputDir + "my_torch_network_final.nn");
+    std::cerr << "Model saved to " << outputDir << "my_torch_network_final.nn" << std::endl;
+    // État de l'optimiseur (moments, nombre de pas) pour reprendre l'entraînement ; rien pour sgd
+    if (!optimizer->stateless()) optimizer->save(outputDir + "my_torch_network_final.opt");
 
     // Confusion Matrix (on whole dataset or just validation? Usually validation, but let's do Validation for now)
     // 3 classes: 0=Nothing/White, 1=Check/Black, 2=Checkmate/Draw
     std::vector<std::vector<int>> confusion(3, std::vector<int>(3, 0));
     
     std::cout << "\nComputing Confusion Matrix on Validation Set..." << std::endl;
-    for (size_t i = trainSize; i < data.size(); ++i) {
-        auto& sample = data[i];
-        auto output = net.forward(sample.first);
-        
-        int predIdx = 0;
-        for(size_t k=1; k<output.size(); ++k) if(output[k] > output[predIdx]) predIdx = k;
-
-        int truthIdx = 0;
-        for(size_t k=1; k<sample.second.size(); ++k) if(sample.second[k] > sample.second[truthIdx]) truthIdx = k;
-        
-        if (predIdx < 3 && truthIdx < 3)
-            confusion[truthIdx][predIdx]++;
+    Prefetcher valBatches(*data, split.validation, batchSize);
+    while (const Minibatch* batch = valBatches.next()) {
+        const nn::Matrix& targets = batch->targets;
+        nn::Matrix output = net.forwardBatch(batch->inputs);
+        for (int b = 0; b < output.rows(); ++b) {
+            int predIdx = argmax(output.row(b));
+            int truthIdx = argmax(targets.row(b));
+            if (predIdx < 3 && truthIdx < 3)
+                confusion[truthIdx][predIdx]++;
+        }
     }
 
     std::cout << "       Pred: 0    1    2" << std::endl;
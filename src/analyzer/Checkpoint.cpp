@@ -0,0 +1,167 @@
+#include "Checkpoint.hpp"
+#include "ModelFile.hpp"
+#include "Network.hpp"
+#include "Optimizer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace analyzer::checkpoint {
+
+namespace {
+
+constexpr int STATE_VERSION = 1;
+constexpr const char* PREFIX = "checkpoint-";
+
+// Force sur disque un fichier ou un répertoire (les entrées créées ou renommées dedans)
+void syncPath(const fs::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::runtime_error("Cannot open " + path.string());
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced) throw std::runtime_error("Cannot sync " + path.string());
+}
+
+// Écrit un petit fichier texte à côté de path puis le renomme (rename est atomique sur un même FS)
+void replaceText(const fs::path& path, const std::string& text) {
+    const fs::path tmp = path.string() + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if (!file || !(file << text) || !file.flush()) {
+            throw std::runtime_error("Cannot write " + tmp.string());
+        }
+    }
+    syncPath(tmp);
+    fs::rename(tmp, path);
+    syncPath(path.parent_path().empty() ? fs::path(".") : path.parent_path());
+}
+
+// Les réels sont écrits avec toute leur précision : la reprise est exacte
+std::string formatState(const TrainingState& state) {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "version=%d\nepoch=%d\nlearning_rate=%.17g\nmonitor=%s\nbest=%.17g\nstale_epochs=%d\nseed=%llu\n",
+                  STATE_VERSION, state.epoch, state.learningRate, state.monitor.c_str(), state.best,
+                  state.staleEpochs, static_cast<unsigned long long>(state.seed));
+    return buffer;
+}
+
+TrainingState parseState(const fs::path& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot open " + path.string());
+
+    TrainingState state;
+    int version = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string key, value;
+        if (!std::getline(ss, key, '=') || !std::getline(ss, value)) continue;
+        if (key == "version") version = std::stoi(value);
+        else if (key == "epoch") state.epoch = std::stoi(value);
+        else if (key == "learning_rate") state.learningRate = std::stod(value);
+        else if (key == "monitor") state.monitor = value;
+        else if (key == "best") state.best = std::stod(value);
+        else if (key == "stale_epochs") state.staleEpochs = std::stoi(value);
+        else if (key == "seed") state.seed = std::stoull(value);
+    }
+    if (version != STATE_VERSION) throw std::runtime_error(path.string() + " is not a training state file");
+    return state;
+}
+
+// Checkpoints de dir triés par époque (le nom est paddé à 4 chiffres, plus si besoin)
+std::vector<fs::path> listCheckpoints(const fs::path& dir) {
+    std::vector<fs::path> found;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_directory() && name.rfind(PREFIX, 0) == 0 && name.find('.') == std::string::npos) {
+            found.push_back(entry.path());
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const fs::path& a, const fs::path& b) {
+        const std::string na = a.filename().string(), nb = b.filename().string();
+        return na.size() != nb.size() ? na.size() < nb.size() : na < nb;
+    });
+    return found;
+}
+
+} // namespace
+
+std::string write(const std::string& dir, const nn::Network& net, const nn::Optimizer& optimizer,
+                  const TrainingState& state, int keep) {
+    fs::create_directories(dir);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s%04d", PREFIX, state.epoch);
+    const fs::path target = fs::path(dir) / name;
+    const fs::path tmp = fs::path(dir) / (std::string(name) + ".tmp");
+    const fs::path old = fs::path(dir) / (std::string(name) + ".old");
+
+    fs::remove_all(tmp);                      // Reste d'une écriture interrompue
+    fs::create_directory(tmp);
+    nn::model::write(net, (tmp / "model.nn").string());
+    optimizer.save((tmp / "optimizer.opt").string());
+    syncPath(tmp / "model.nn");
+    syncPath(tmp / "optimizer.opt");
+    replaceText(tmp / "state", formatState(state));
+
+    // Reprise depuis un checkpoint plus ancien : l'existant est mis de côté, pas supprimé, tant que
+    // le nouveau n'est pas en place (read() se rabat sur .old si le processus meurt entre les deux)
+    if (fs::exists(target)) {
+        fs::remove_all(old);
+        fs::rename(target, old);
+    }
+    fs::rename(tmp, target);
+    syncPath(dir);
+    replaceText(fs::path(dir) / "latest", std::string(name) + "\n");
+    fs::remove_all(old);
+
+    if (keep > 0) {
+        std::vector<fs::path> all = listCheckpoints(dir);
+        for (size_t i = 0; i + keep < all.size(); ++i) {
+            if (all[i] != target) fs::remove_all(all[i]);
+        }
+    }
+    return target.string();
+}
+
+TrainingState read(const std::string& path, nn::Network& net, nn::Optimizer& optimizer) {
+    fs::path checkpointPath = path;
+    if (!fs::exists(checkpointPath / "state")) {
+        std::ifstream latest(checkpointPath / "latest");
+        std::string name;
+        if (!latest || !std::getline(latest, name) || name.empty()) {
+            throw std::runtime_error(path + " is neither a checkpoint nor a checkpoint directory");
+        }
+        checkpointPath /= name;
+        if (!fs::exists(checkpointPath / "state") && fs::exists(checkpointPath.string() + ".old/state")) {
+            checkpointPath += ".old";
+        }
+    }
+
+    TrainingState state = parseState(checkpointPath / "state");
+    nn::model::read((checkpointPath / "model.nn").string(), net);
+    optimizer.load((checkpointPath / "optimizer.opt").string());
+    std::cerr << "Resuming from " << checkpointPath.string() << " (epoch " << state.epoch << ")" << std::endl;
+    return state;
+}
+
+void saveModel(const nn::Network& net, const std::string& path) {
+    const std::string tmp = path + ".tmp";
+    nn::model::write(net, tmp);
+    syncPath(tmp);
+    fs::rename(tmp, path);
+    const fs::path parent = fs::path(path).parent_path();
+    syncPath(parent.empty() ? fs::path(".") : parent);
+}
+
+} // namespace analyzer::checkpoint
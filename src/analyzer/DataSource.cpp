@@ -0,0 +1,172 @@
+#include "DataSource.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace analyzer {
+
+std::unique_ptr<DataSource> DataSource::open(const std::string& path, bool streaming, int threads,
+                                             const FeatureExtractor& features) {
+    const auto files = Dataset::expandPaths(path);
+    if (files.size() == 1 && PackedDataset::isPacked(files.front())) return std::make_unique<PackedSource>(files.front(), features);
+    if (streaming) {
+        if (files.size() != 1) throw std::runtime_error("Streaming needs a single dataset file (pack several files first)");
+        return std::make_unique<TextStreamSource>(files.front(), features);
+    }
+    return std::make_unique<MemorySource>(Dataset::loadSparse(path, threads, features), features.featureCount());
+}
+
+Split stratifiedSplit(const DataSource& source, double validationRatio, std::mt19937_64& rng) {
+    std::vector<std::vector<std::size_t>> byClass(std::max(1, source.classCount()));
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        const int label = source.label(i);
+        byClass[label >= 0 && label < static_cast<int>(byClass.size()) ? label : 0].push_back(i);
+    }
+
+    Split split;
+    const double ratio = std::clamp(validationRatio, 0.0, 1.0);
+    for (auto& members : byClass) {
+        std::shuffle(members.begin(), members.end(), rng);
+        const auto valCount = static_cast<std::size_t>(std::llround(members.size() * ratio));
+        split.validation.insert(split.validation.end(), members.begin(), members.begin() + valCount);
+        split.train.insert(split.train.end(), members.begin() + valCount, members.end());
+    }
+    // Ordre croissant : les lectures de la validation restent séquentielles
+    std::sort(split.train.begin(), split.train.end());
+    std::sort(split.validation.begin(), split.validation.end());
+    return split;
+}
+
+// ---------------------------------------------------------------------------
+// MemorySource
+// ---------------------------------------------------------------------------
+
+MemorySource::MemorySource(std::vector<SparseSample> samples, int featureCount)
+    : samples(std::move(samples)), featureCount(featureCount) {}
+
+int MemorySource::classCount() const {
+    return samples.empty() ? 0 : static_cast<int>(samples.front().target.size());
+}
+
+int MemorySource::label(std::size_t i) const {
+    const auto& target = samples[i].target;
+    return static_cast<int>(std::max_element(target.begin(), target.end()) - target.begin());
+}
+
+void MemorySource::fill(std::span<const std::size_t> rows, Minibatch& batch) const {
+    batch.inputs.clear(featureCount);
+    batch.targets.resize(static_cast<int>(rows.size()), classCount());
+    for (int b = 0; b < static_cast<int>(rows.size()); ++b) {
+        const auto& sample = samples[rows[b]];
+        batch.inputs.addRow(sample.indices);
+        std::copy(sample.target.begin(), sample.target.end(), batch.targets.row(b).begin());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PackedSource
+// ---------------------------------------------------------------------------
+
+void PackedSource::fill(std::span<const std::size_t> rows, Minibatch& batch) const {
+    std::vector<int> indices;
+    int extended[FeatureExtractor::MAX_ACTIVE];
+    Position position;
+    batch.inputs.clear(features.featureCount());
+    batch.targets.resize(static_cast<int>(rows.size()), data.classCount());
+    for (int b = 0; b < static_cast<int>(rows.size()); ++b) {
+        const int label = data.label(rows[b]);
+        indices.clear();
+        data.indices(rows[b], indices);
+        if (features.sets() == FeatureExtractor::BASE) {
+            batch.inputs.addRow(indices);
+        } else {
+            if (!Position::fromFeatures(indices, position)) throw std::runtime_error("Corrupted packed dataset");
+            batch.inputs.addRow(std::span<const int>(extended, features.extract(position, extended)));
+        }
+        if (label < batch.targets.cols()) batch.targets(b, label) = 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TextStreamSource
+// ---------------------------------------------------------------------------
+
+TextStreamSource::TextStreamSource(const std::string& path, const FeatureExtractor& features) : features(features) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open dataset file " + path);
+
+    // Indexation : une passe séquentielle qui ne garde que la position des lignes valides
+    std::vector<char> chunk(1 << 20);
+    std::string line;
+    std::string_view fen;
+    int label;
+    int indices[FeatureExtractor::MAX_ACTIVE];
+    std::uint64_t offset = 0;      // Début de line dans le fichier
+    ssize_t received;
+    auto finishLine = [&] {
+        if (Dataset::parseLine(std::string_view(line), fen, label) && features.extract(fen, indices) >= 0) {
+            starts.push_back(offset);
+            lengths.push_back(static_cast<std::uint32_t>(line.size()));
+            labels.push_back(static_cast<std::uint8_t>(label));
+            classes = Dataset::CLASS_COUNT;
+        }
+        offset += line.size() + 1;
+        line.clear();
+    };
+    while ((received = ::read(fd, chunk.data(), chunk.size())) > 0) {
+        const char* p = chunk.data();
+        const char* stop = p + received;
+        while (p < stop) {
+            const char* newline = std::find(p, stop, '\n');
+            line.append(p, newline);
+            if (newline == stop) break;
+            finishLine();
+            p = newline + 1;
+        }
+    }
+    if (!line.empty()) finishLine();
+}
+
+TextStreamSource::~TextStreamSource() {
+    if (fd >= 0) ::close(fd);
+}
+
+void TextStreamSource::fill(std::span<const std::size_t> rows, Minibatch& batch) const {
+    const int count = static_cast<int>(rows.size());
+    batch.inputs.clear(features.featureCount());
+    batch.targets.resize(count, classes);
+
+    std::string buffer;
+    std::string_view fen;
+    int label;
+    int indices[FeatureExtractor::MAX_ACTIVE];
+    for (int b = 0; b < count;) {
+        // Les lignes d'indices consécutifs sont contiguës dans le fichier (aux lignes invalides près) :
+        // une seule lecture par suite, donc par batch quand l'ordre n'est pas mélangé
+        int runEnd = b + 1;
+        while (runEnd < count && rows[runEnd] == rows[runEnd - 1] + 1) runEnd++;
+        const std::uint64_t first = starts[rows[b]];
+        const std::uint64_t last = starts[rows[runEnd - 1]] + lengths[rows[runEnd - 1]];
+        buffer.resize(last - first);
+        std::size_t done = 0;
+        while (done < buffer.size()) {
+            ssize_t received = ::pread(fd, buffer.data() + done, buffer.size() - done, first + done);
+            if (received <= 0) throw std::runtime_error("Dataset file changed or became unreadable during training");
+            done += received;
+        }
+
+        for (; b < runEnd; ++b) {
+            const std::string_view line(buffer.data() + (starts[rows[b]] - first), lengths[rows[b]]);
+            int active;
+            if (!Dataset::parseLine(line, fen, label) || (active = features.extract(fen, indices)) < 0) {
+                throw std::runtime_error("Dataset file changed during training");
+            }
+            batch.inputs.addRow(std::span<const int>(indices, active));
+            batch.targets(b, label) = 1;
+        }
+    }
+}
+
+} // namespace analyzer
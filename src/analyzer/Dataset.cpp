@@ -1,68 +1,193 @@
 #include "Dataset.hpp"
 #include "FENParser.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <memory>
 #include <iostream>
+#include <glob.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace analyzer {
 
-std::vector<std::pair<std::vector<double>, std::vector<double>>> Dataset::load(const std::string& path) {
-    std::vector<std::pair<std::vector<double>, std::vector<double>>> data;
-    std::ifstream file(path);
-    
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open dataset file " << path << std::endl;
-        return data;
-    }
+namespace {
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-
-        std::string fen, label;
-        
-        // Try finding semicolon first
-        size_t sepPos = line.find(';');
-        if (sepPos == std::string::npos) {
-            // If no semicolon, find LAST space (because FEN can contain spaces)
-            sepPos = line.find_last_of(' ');
+// Fichier mappé en lecture seule
+struct MappedFile {
+    const char* data = nullptr;
+    std::size_t size = 0;
+    bool opened = false;           // Vrai aussi pour un fichier vide
+
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        opened = ::fstat(fd, &st) == 0;
+        if (opened && st.st_size > 0) {
+            void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data = static_cast<const char*>(addr);
+                size = st.st_size;
+            }
         }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data) ::munmap(const_cast<char*>(data), size);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
 
-        if (sepPos == std::string::npos) {
-            continue; // Invalid format
+// Analyse les lignes de [begin, end) ; begin est un début de ligne. Les FEN invalides sont ignorés.
+void scanChunk(const char* begin, const char* end, const FeatureExtractor& features, std::vector<SparseSample>& out) {
+    std::string_view fen;
+    int label;
+    int indices[FeatureExtractor::MAX_ACTIVE];
+    while (begin < end) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        const char* lineEnd = newline ? newline : end;
+        int count;
+        if (Dataset::parseLine(std::string_view(begin, lineEnd - begin), fen, label) &&
+            (count = features.extract(fen, indices)) >= 0) {
+            SparseSample sample;
+            sample.indices.assign(indices, indices + count);
+            sample.target.assign(Dataset::CLASS_COUNT, 0.0);
+            sample.target[label] = 1.0;
+            out.push_back(std::move(sample));
         }
+        begin = lineEnd + 1;
+    }
+}
+
+// Un fichier binaire (.mtds, modèle, ...) contient un octet nul dans ses premiers Ko
+bool looksLikeText(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    char head[4096];
+    file.read(head, sizeof(head));
+    return file.gcount() > 0 && std::memchr(head, '\0', file.gcount()) == nullptr;
+}
+
+} // namespace
+
+int Dataset::labelIndex(std::string_view label) {
+    if (label == "Nothing" || label == "White" || label == "1-0") return 0;
+    if (label == "Check" || label == "Black" || label == "0-1") return 1;
+    if (label == "Checkmate" || label == "Draw" || label == "1/2-1/2") return 2;
+    return -1;
+}
+
+bool Dataset::parseLine(std::string_view line, std::string_view& fen, int& label) {
+    if (line.empty()) return false;
+
+    // Try finding semicolon first
+    size_t sepPos = line.find(';');
+    if (sepPos == std::string_view::npos) {
+        // If no semicolon, find LAST space (because FEN can contain spaces)
+        sepPos = line.find_last_of(' ');
+    }
+
+    if (sepPos == std::string_view::npos) {
+        return false; // Invalid format
+    }
+
+    fen = line.substr(0, sepPos);
+    label = labelIndex(line.substr(sepPos + 1));
+    return label >= 0;
+}
+
+bool Dataset::parseLine(const std::string& line, std::string& fen, nn::Vector& target) {
+    std::string_view fenView;
+    int label;
+    if (!parseLine(std::string_view(line), fenView, label)) return false;
+    fen.assign(fenView);
+    target.assign(CLASS_COUNT, 0.0);
+    target[label] = 1.0;
+    return true;
+}
 
-        fen = line.substr(0, sepPos);
-        label = line.substr(sepPos + 1);
-        
-        // Trim potential whitespace around label if needed (though find_last_of ' ' puts us right before it)
-        // Ideally we trim the label just in case
-        // But for now simple extraction:
-
-
-        std::vector<double> input = FENParser::fenToVector(fen);
-        std::vector<double> target;
-
-        if (label == "Nothing") {
-            target = {1.0, 0.0, 0.0};
-        } else if (label == "Check") {
-            target = {0.0, 1.0, 0.0};
-        } else if (label == "Checkmate") {
-            target = {0.0, 0.0, 1.0};
-        } else if (label == "White" || label == "1-0") {
-             target = {1.0, 0.0, 0.0};
-        } else if (label == "Black" || label == "0-1") {
-             target = {0.0, 1.0, 0.0};
-        } else if (label == "Draw" || label == "1/2-1/2") {
-             target = {0.0, 0.0, 1.0};
-        } else {
-            // Unknown label
-            continue;
+std::vector<std::string> Dataset::expandPaths(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    std::error_code ec;
+
+    if (fs::is_directory(path, ec)) {
+        for (const auto& entry : fs::recursive_directory_iterator(path, ec)) {
+            if (entry.is_regular_file(ec) && looksLikeText(entry.path())) files.push_back(entry.path().string());
+        }
+    } else if (fs::exists(path, ec)) {
+        files.push_back(path);
+    } else {
+        glob_t matches;
+        if (::glob(path.c_str(), 0, nullptr, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; ++i) {
+                if (fs::is_regular_file(matches.gl_pathv[i], ec)) files.push_back(matches.gl_pathv[i]);
+            }
         }
+        ::globfree(&matches);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
 
-        data.emplace_back(input, target);
+std::vector<std::pair<nn::Vector, nn::Vector>> Dataset::load(const std::string& path, int threads) {
+    std::vector<std::pair<nn::Vector, nn::Vector>> data;
+    for (auto& sample : loadSparse(path, threads)) {
+        nn::Vector features(FENParser::FEATURE_COUNT, 0.0);
+        for (int idx : sample.indices) features[idx] = 1.0;
+        data.emplace_back(std::move(features), std::move(sample.target));
     }
+    return data;
+}
+
+std::vector<SparseSample> Dataset::loadSparse(const std::string& path, int threads, const FeatureExtractor& features,
+                                               std::size_t chunkBytes) {
+    std::vector<SparseSample> data;
+    const auto paths = expandPaths(path);
 
+    if (paths.empty()) {
+        std::cerr << "Error: Could not open dataset file " << path << std::endl;
+        return data;
+    }
+
+    // Tranches d'environ chunkBytes octets, coupées après un '\n'
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<std::pair<const char*, const char*>> chunks;
+    for (const auto& file : paths) {
+        files.push_back(std::make_unique<MappedFile>(file));
+        const MappedFile& mapped = *files.back();
+        if (!mapped.opened) std::cerr << "Error: Could not open dataset file " << file << std::endl;
+        if (!mapped.data) continue;
+        const char* begin = mapped.data;
+        const char* end = mapped.data + mapped.size;
+        while (begin < end) {
+            const char* cut = begin + std::min(std::max<std::size_t>(chunkBytes, 1), static_cast<std::size_t>(end - begin));
+            if (cut < end) {
+                const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+                cut = newline ? newline + 1 : end;
+            }
+            chunks.emplace_back(begin, cut);
+            begin = cut;
+        }
+    }
+
+    std::vector<std::vector<SparseSample>> parts(chunks.size());
+    nn::ThreadPool pool(std::max(1, threads));
+    pool.parallelFor(static_cast<int>(chunks.size()), [&](int c) {
+        scanChunk(chunks[c].first, chunks[c].second, features, parts[c]);
+    });
+
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    data.reserve(total);
+    for (auto& part : parts) {
+        std::move(part.begin(), part.end(), std::back_inserter(data));
+    }
     return data;
 }
 
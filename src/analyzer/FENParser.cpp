@@ -1,65 +1,143 @@
 #include "FENParser.hpp"
-#include <sstream>
-#include <cctype>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
 namespace analyzer {
 
-std::vector<double> FENParser::fenToVector(const std::string& fen) {
-    std::vector<double> features;
-    features.reserve(838);
+namespace {
 
-    std::stringstream ss(fen);
-    std::string board, activeColor, castling, enPassant;
-    ss >> board >> activeColor >> castling >> enPassant;
+constexpr int BOARD_FEATURES = 64 * 13;
+constexpr int SIDE_TO_MOVE = BOARD_FEATURES;       // 832
+constexpr int CASTLING = BOARD_FEATURES + 1;       // 833-836 : K, Q, k, q
+constexpr int EN_PASSANT = BOARD_FEATURES + 5;     // 837
 
-    // 1. Board (832 features)
+// Canal one-hot d'une case : 0 = vide, 1-6 = PNBRQK, 7-12 = pnbrqk
+constexpr std::array<std::int8_t, 256> CHANNELS = [] {
+    std::array<std::int8_t, 256> table{};
+    const char pieces[] = "PNBRQKpnbrqk";
+    for (int i = 0; i < 12; ++i) table[static_cast<unsigned char>(pieces[i])] = static_cast<std::int8_t>(i + 1);
+    return table;
+}();
+
+int pieceChannel(char c) {
+    return CHANNELS[static_cast<unsigned char>(c)];
+}
+
+// Champ suivant séparé par des espaces ; vide à la fin de la chaîne
+std::string_view nextField(std::string_view fen, size_t& pos) {
+    while (pos < fen.size() && fen[pos] == ' ') ++pos;
+    const size_t start = pos;
+    while (pos < fen.size() && fen[pos] != ' ') ++pos;
+    return fen.substr(start, pos - start);
+}
+
+} // namespace
+
+bool FENParser::parseCounter(std::string_view field, int& value) {
+    if (field.empty() || field.size() > MAX_COUNTER_DIGITS) return false;
+    value = 0;
+    for (char c : field) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+int FENParser::featureIndex(int square, char piece) {
+    return square * 13 + pieceChannel(piece);
+}
+
+int FENParser::toIndices(std::string_view fen, std::span<int> indices) {
+    if (indices.size() < static_cast<size_t>(MAX_ACTIVE)) return -1;
+    size_t pos = 0;
+    int count = 0;
+
+    // 1. Board (832 features) : un seul canal actif sur 13 par case
+    const std::string_view board = nextField(fen, pos);
+    int square = 0;
+    int file = 0;
+    int rank = 0;
     for (char c : board) {
-        if (c == '/') continue;
-        
-        if (isdigit(c)) {
-            int emptyCount = c - '0';
-            for (int i = 0; i < emptyCount; ++i) {
-                // Empty square: index 0 is 1, others 0
-                features.push_back(1.0); // Index 0
-                for(int k=1; k<13; ++k) features.push_back(0.0);
-            }
+        if (c == '/') {
+            if (file != 8 || ++rank > 7) return -1;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            const int emptyCount = c - '0';
+            if (file + emptyCount > 8) return -1;
+            for (int i = 0; i < emptyCount; ++i) indices[count++] = square++ * 13;
+            file += emptyCount;
         } else {
-            // Piece
-            int idx = 0;
-            switch(c) {
-                case 'P': idx = 1; break;
-                case 'N': idx = 2; break;
-                case 'B': idx = 3; break;
-                case 'R': idx = 4; break;
-                case 'Q': idx = 5; break;
-                case 'K': idx = 6; break;
-                case 'p': idx = 7; break;
-                case 'n': idx = 8; break;
-                case 'b': idx = 9; break;
-                case 'r': idx = 10; break;
-                case 'q': idx = 11; break;
-                case 'k': idx = 12; break;
-            }
-            
-            for(int k=0; k<13; ++k) {
-                features.push_back(k == idx ? 1.0 : 0.0);
-            }
+            const int channel = pieceChannel(c);
+            if (channel == 0 || file == 8) return -1;
+            indices[count++] = square++ * 13 + channel;
+            ++file;
         }
     }
+    if (rank != 7 || file != 8) return -1;
 
     // 2. Active Color (1 feature)
-    features.push_back(activeColor == "w" ? 1.0 : 0.0);
+    const std::string_view activeColor = nextField(fen, pos);
+    if (activeColor == "w") indices[count++] = SIDE_TO_MOVE;
+    else if (activeColor != "b") return -1;
 
-    // 3. Castling (4 features)
-    features.push_back(castling.find('K') != std::string::npos ? 1.0 : 0.0);
-    features.push_back(castling.find('Q') != std::string::npos ? 1.0 : 0.0);
-    features.push_back(castling.find('k') != std::string::npos ? 1.0 : 0.0);
-    features.push_back(castling.find('q') != std::string::npos ? 1.0 : 0.0);
+    // 3. Castling (4 features), émis dans l'ordre KQkq quel que soit l'ordre du FEN
+    const std::string_view castling = nextField(fen, pos);
+    if (castling.empty()) return -1;
+    if (castling != "-") {
+        bool rights[4] = {};
+        for (char c : castling) {
+            const size_t right = std::string_view("KQkq").find(c);
+            if (right == std::string_view::npos || rights[right]) return -1;
+            rights[right] = true;
+        }
+        for (int r = 0; r < 4; ++r) {
+            if (rights[r]) indices[count++] = CASTLING + r;
+        }
+    }
 
     // 4. En Passant (1 feature)
-    features.push_back(enPassant != "-" ? 1.0 : 0.0);
+    const std::string_view enPassant = nextField(fen, pos);
+    if (enPassant != "-") {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' ||
+            (enPassant[1] != '3' && enPassant[1] != '6')) {
+            return -1;
+        }
+        indices[count++] = EN_PASSANT;
+    }
+
+    // 5. Compteurs de demi-coups et de coups : optionnels et ignorés. Ce qui suit le second
+    // (annotations des datasets bruts, ex. "... 4 70 Checkmate") n'appartient pas au FEN.
+    for (int i = 0; i < 2; ++i) {
+        const std::string_view counter = nextField(fen, pos);
+        if (counter.empty()) break;
+        int value;
+        if (!parseCounter(counter, value)) return -1;
+    }
+    return count;
+}
+
+bool FENParser::toFeatures(std::string_view fen, std::span<nn::Scalar> features) {
+    int indices[MAX_ACTIVE];
+    const int count = toIndices(fen, indices);
+    if (count < 0 || features.size() != static_cast<size_t>(FEATURE_COUNT)) return false;
+    std::fill(features.begin(), features.end(), nn::Scalar(0));
+    for (int i = 0; i < count; ++i) features[indices[i]] = 1;
+    return true;
+}
 
+nn::Vector FENParser::fenToVector(const std::string& fen) {
+    nn::Vector features(FEATURE_COUNT, 0.0);
+    toFeatures(fen, features);
     return features;
 }
 
+bool FENParser::fenToIndices(const std::string& fen, std::vector<int>& indices) {
+    int parsed[MAX_ACTIVE];
+    const int count = toIndices(fen, parsed);
+    if (count < 0) return false;
+    indices.insert(indices.end(), parsed, parsed + count);
+    return true;
+}
+
 } // namespace analyzer
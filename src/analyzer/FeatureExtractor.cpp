@@ -0,0 +1,189 @@
+#include "FeatureExtractor.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+namespace analyzer {
+
+namespace {
+
+constexpr int BOARD_FEATURES = 64 * 13;
+constexpr std::uint64_t FILE_A = 0x0101010101010101ull;
+constexpr std::uint64_t FILE_H = FILE_A << 7;
+
+// Directions (rangée, colonne) ; la rangée croît vers la rangée 1 (indices croissants)
+constexpr int DIRECTIONS[8][2] = {{0, 1}, {1, -1}, {1, 0}, {1, 1}, {0, -1}, {-1, 1}, {-1, 0}, {-1, -1}};
+
+struct Tables {
+    std::array<std::uint64_t, 64> knight{};
+    std::array<std::uint64_t, 64> king{};
+    std::array<std::array<std::uint64_t, 64>, 8> rays{};   // Cases jusqu'au bord, case de départ exclue
+
+    constexpr Tables() {
+        constexpr int KNIGHT[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        for (int sq = 0; sq < 64; ++sq) {
+            const int r = sq / 8, f = sq % 8;
+            for (const auto& d : KNIGHT) {
+                if (r + d[0] >= 0 && r + d[0] < 8 && f + d[1] >= 0 && f + d[1] < 8) {
+                    knight[sq] |= 1ull << ((r + d[0]) * 8 + f + d[1]);
+                }
+            }
+            for (int dir = 0; dir < 8; ++dir) {
+                const int dr = DIRECTIONS[dir][0], df = DIRECTIONS[dir][1];
+                if (r + dr >= 0 && r + dr < 8 && f + df >= 0 && f + df < 8) king[sq] |= 1ull << ((r + dr) * 8 + f + df);
+                for (int rr = r + dr, ff = f + df; rr >= 0 && rr < 8 && ff >= 0 && ff < 8; rr += dr, ff += df) {
+                    rays[dir][sq] |= 1ull << (rr * 8 + ff);
+                }
+            }
+        }
+    }
+};
+
+constexpr Tables TABLES;
+
+// Attaques glissantes par rayons : le premier bloqueur (bit le plus proche) arrête le rayon
+std::uint64_t slide(int sq, std::uint64_t occupancy, int firstDir, int step) {
+    std::uint64_t result = 0;
+    for (int dir = firstDir; dir < 8; dir += step) {
+        const std::uint64_t ray = TABLES.rays[dir][sq];
+        const std::uint64_t blockers = ray & occupancy;
+        if (!blockers) {
+            result |= ray;
+            continue;
+        }
+        // Directions 0..3 : indices croissants, bloqueur = bit de poids faible
+        const int blocker = dir < 4 ? std::countr_zero(blockers) : 63 - std::countl_zero(blockers);
+        result |= ray ^ TABLES.rays[dir][blocker];
+    }
+    return result;
+}
+
+std::uint64_t rookAttacks(int sq, std::uint64_t occupancy) { return slide(sq, occupancy, 0, 2); }
+std::uint64_t bishopAttacks(int sq, std::uint64_t occupancy) { return slide(sq, occupancy, 1, 2); }
+
+int countFeatures(unsigned sets) {
+    int count = FENParser::FEATURE_COUNT;
+    if (sets & FeatureExtractor::ATTACKS) count += FeatureExtractor::ATTACK_FEATURES;
+    if (sets & FeatureExtractor::KING_ZONE) count += FeatureExtractor::KING_ZONE_FEATURES;
+    if (sets & FeatureExtractor::PIECE_COUNTS) count += FeatureExtractor::PIECE_COUNT_FEATURES;
+    return count;
+}
+
+constexpr std::pair<std::string_view, unsigned> SET_NAMES[] = {
+    {"attacks", FeatureExtractor::ATTACKS},
+    {"king_zone", FeatureExtractor::KING_ZONE},
+    {"piece_counts", FeatureExtractor::PIECE_COUNTS},
+};
+
+} // namespace
+
+FeatureExtractor::FeatureExtractor(unsigned sets) : enabled(sets & ALL), count(countFeatures(enabled)) {}
+
+FeatureExtractor FeatureExtractor::parse(std::string_view spec) {
+    unsigned sets = BASE;
+    while (!spec.empty()) {
+        const size_t comma = spec.find(',');
+        std::string_view name = spec.substr(0, comma);
+        spec = comma == std::string_view::npos ? std::string_view() : spec.substr(comma + 1);
+        while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+        if (name.empty() || name == "base") continue;
+
+        const auto* found = std::find_if(std::begin(SET_NAMES), std::end(SET_NAMES),
+                                         [&](const auto& entry) { return entry.first == name; });
+        if (found == std::end(SET_NAMES)) throw std::runtime_error("Unknown feature set: " + std::string(name));
+        sets |= found->second;
+    }
+    return FeatureExtractor(sets);
+}
+
+bool FeatureExtractor::forInputSize(int size, FeatureExtractor& extractor) {
+    for (unsigned sets = BASE; sets <= ALL; ++sets) {
+        if (countFeatures(sets) == size) {
+            extractor = FeatureExtractor(sets);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string FeatureExtractor::name() const {
+    std::string result = "base";
+    for (const auto& [setName, bit] : SET_NAMES) {
+        if (enabled & bit) result += "," + std::string(setName);
+    }
+    return result;
+}
+
+std::uint64_t FeatureExtractor::attacks(const Position& position, bool white) {
+    const int offset = white ? 0 : 6;
+    const std::uint64_t occupancy = position.occupancy();
+    const std::uint64_t pawns = position.pieces(Position::W_PAWN + offset);
+
+    // Les blancs avancent vers la rangée 8 (indices décroissants)
+    std::uint64_t result = white ? ((pawns & ~FILE_A) >> 9) | ((pawns & ~FILE_H) >> 7)
+                                 : ((pawns & ~FILE_A) << 7) | ((pawns & ~FILE_H) << 9);
+    for (std::uint64_t b = position.pieces(Position::W_KNIGHT + offset); b; b &= b - 1) result |= TABLES.knight[std::countr_zero(b)];
+    for (std::uint64_t b = position.pieces(Position::W_KING + offset); b; b &= b - 1) result |= TABLES.king[std::countr_zero(b)];
+    const std::uint64_t queens = position.pieces(Position::W_QUEEN + offset);
+    for (std::uint64_t b = position.pieces(Position::W_BISHOP + offset) | queens; b; b &= b - 1) {
+        result |= bishopAttacks(std::countr_zero(b), occupancy);
+    }
+    for (std::uint64_t b = position.pieces(Position::W_ROOK + offset) | queens; b; b &= b - 1) {
+        result |= rookAttacks(std::countr_zero(b), occupancy);
+    }
+    return result;
+}
+
+int FeatureExtractor::extract(const Position& position, std::span<int> indices) const {
+    if (indices.size() < static_cast<size_t>(MAX_ACTIVE)) return -1;
+
+    // Base : canal de chaque case (mailbox reconstruite depuis les bitboards), puis drapeaux
+    std::array<std::uint8_t, 64> board{};
+    for (int piece = 0; piece < Position::PIECE_COUNT; ++piece) {
+        for (std::uint64_t b = position.pieces(piece); b; b &= b - 1) board[std::countr_zero(b)] = static_cast<std::uint8_t>(piece + 1);
+    }
+    int n = 0;
+    for (int sq = 0; sq < 64; ++sq) indices[n++] = sq * 13 + board[sq];
+    if (position.whiteToMove()) indices[n++] = BOARD_FEATURES;
+    for (int right = 0; right < 4; ++right) {
+        if (position.castling() & (1u << right)) indices[n++] = BOARD_FEATURES + 1 + right;
+    }
+    if (position.hasEnPassant()) indices[n++] = BOARD_FEATURES + 5;
+
+    int base = FENParser::FEATURE_COUNT;
+    if (enabled & ATTACKS) {
+        for (int side = 0; side < 2; ++side) {
+            for (std::uint64_t b = attacks(position, side == 0); b; b &= b - 1) indices[n++] = base + std::countr_zero(b);
+            base += 64;
+        }
+    }
+    if (enabled & KING_ZONE) {
+        const std::uint64_t sides[2] = {position.white(), position.black()};
+        for (int side = 0; side < 2; ++side) {
+            const std::uint64_t king = position.pieces(side == 0 ? Position::W_KING : Position::B_KING);
+            const std::uint64_t zone = king ? TABLES.king[std::countr_zero(king)] : 0;
+            indices[n++] = base + std::popcount(zone & sides[side]);
+            indices[n++] = base + 9 + std::popcount(zone & sides[1 - side]);
+            base += 18;
+        }
+    }
+    if (enabled & PIECE_COUNTS) {
+        for (int piece = 0; piece < Position::PIECE_COUNT; ++piece) {
+            if (piece == Position::W_KING || piece == Position::B_KING) continue;
+            indices[n++] = base + std::min(std::popcount(position.pieces(piece)), 8);
+            base += 9;
+        }
+    }
+    return n;
+}
+
+int FeatureExtractor::extract(std::string_view fen, std::span<int> indices) const {
+    if (enabled == BASE) return FENParser::toIndices(fen, indices);
+    Position position;
+    if (!Position::fromFen(fen, position)) return -1;
+    return extract(position, indices);
+}
+
+} // namespace analyzer
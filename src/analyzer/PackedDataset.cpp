@@ -0,0 +1,130 @@
+#include "PackedDataset.hpp"
+#include "Dataset.hpp"
+#include "FENParser.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace analyzer {
+
+namespace {
+
+constexpr int SQUARES = 64;
+constexpr int CHANNELS = 13;
+constexpr int BOARD_FEATURES = SQUARES * CHANNELS;   // 832, puis les 6 flags
+constexpr std::uint8_t ABSENT = 0xF;
+
+} // namespace
+
+PackedBoard PackedDataset::encode(std::span<const int> indices, int label) {
+    PackedBoard board;
+    std::memset(board.squares, 0xFF, sizeof(board.squares));
+    board.flags = 0;
+    board.label = static_cast<std::uint8_t>(label);
+    for (int idx : indices) {
+        if (idx < BOARD_FEATURES) {
+            const int square = idx / CHANNELS;
+            const int shift = (square & 1) * 4;
+            std::uint8_t& byte = board.squares[square / 2];
+            byte = static_cast<std::uint8_t>((byte & ~(0xF << shift)) | ((idx % CHANNELS) << shift));
+        } else {
+            board.flags |= static_cast<std::uint8_t>(1u << (idx - BOARD_FEATURES));
+        }
+    }
+    return board;
+}
+
+void PackedDataset::decode(const PackedBoard& board, std::vector<int>& indices) {
+    for (int square = 0; square < SQUARES; ++square) {
+        const int channel = (board.squares[square / 2] >> ((square & 1) * 4)) & 0xF;
+        if (channel != ABSENT) indices.push_back(square * CHANNELS + channel);
+    }
+    for (int bit = 0; bit < FENParser::FEATURE_COUNT - BOARD_FEATURES; ++bit) {
+        if (board.flags & (1u << bit)) indices.push_back(BOARD_FEATURES + bit);
+    }
+}
+
+bool PackedDataset::isPacked(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+std::size_t PackedDataset::pack(const std::string& textPath, const std::string& outputPath) {
+    const auto files = Dataset::expandPaths(textPath);
+    if (files.empty()) throw std::runtime_error("Cannot open dataset file " + textPath);
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) throw std::runtime_error("Cannot write dataset file " + outputPath);
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordSize = sizeof(PackedBoard);
+    header.classCount = Dataset::CLASS_COUNT;
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header)); // count complété à la fin
+
+    std::string line;
+    std::string_view fen;
+    int label;
+    int indices[FENParser::MAX_ACTIVE];
+    std::vector<PackedBoard> pending;
+    pending.reserve(4096);
+    auto flush = [&] {
+        output.write(reinterpret_cast<const char*>(pending.data()), pending.size() * sizeof(PackedBoard));
+        pending.clear();
+    };
+
+    for (const auto& file : files) {
+        std::ifstream input(file);
+        if (!input.is_open()) throw std::runtime_error("Cannot open dataset file " + file);
+        while (std::getline(input, line)) {
+            if (!Dataset::parseLine(std::string_view(line), fen, label)) continue;
+            const int count = FENParser::toIndices(fen, indices);
+            if (count < 0) continue;
+            pending.push_back(encode(std::span<const int>(indices, count), label));
+            header.count++;
+            if (pending.size() == pending.capacity()) flush();
+        }
+    }
+    flush();
+
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    if (!output) throw std::runtime_error("Cannot write dataset file " + outputPath);
+    return header.count;
+}
+
+PackedDataset::PackedDataset(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open dataset file " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Dataset file too small: " + path);
+    }
+    const std::size_t size = st.st_size;
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("Cannot map dataset file " + path);
+    mapping = std::shared_ptr<void>(addr, [size](void* p) { ::munmap(p, size); });
+    const unsigned char* base = static_cast<const unsigned char*>(addr);
+
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("Not a packed dataset: " + path);
+    if (header.version != VERSION || header.recordSize != sizeof(PackedBoard)) {
+        throw std::runtime_error("Unsupported dataset version " + std::to_string(header.version));
+    }
+    if (sizeof(Header) + header.count * sizeof(PackedBoard) != size) {
+        throw std::runtime_error("Truncated dataset file " + path);
+    }
+    records = reinterpret_cast<const PackedBoard*>(base + sizeof(Header));
+    count = header.count;
+    classes = static_cast<int>(header.classCount);
+}
+
+} // namespace analyzer
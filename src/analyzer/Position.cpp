@@ -0,0 +1,178 @@
+#include "Position.hpp"
+#include "FENParser.hpp"
+
+namespace analyzer {
+
+namespace {
+
+constexpr char PIECE_CHARS[] = "PNBRQKpnbrqk";
+constexpr int BOARD_FEATURES = 64 * 13;
+
+// Index de PIECE_CHARS pour chaque caractère, -1 si ce n'est pas une pièce
+constexpr auto PIECES = [] {
+    std::array<std::int8_t, 256> table{};
+    table.fill(-1);
+    for (int i = 0; i < 12; ++i) table[static_cast<unsigned char>(PIECE_CHARS[i])] = static_cast<std::int8_t>(i);
+    return table;
+}();
+
+std::string_view nextField(std::string_view fen, size_t& pos) {
+    while (pos < fen.size() && fen[pos] == ' ') ++pos;
+    const size_t start = pos;
+    while (pos < fen.size() && fen[pos] != ' ') ++pos;
+    return fen.substr(start, pos - start);
+}
+
+std::uint64_t mix(std::uint64_t x) {
+    // splitmix64
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+bool Position::fromFen(std::string_view fen, Position& position) {
+    Position p;
+    size_t pos = 0;
+
+    const std::string_view board = nextField(fen, pos);
+    int square = 0, file = 0, rank = 0;
+    for (char c : board) {
+        if (c == '/') {
+            if (file != 8 || ++rank > 7) return false;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            if (file + (c - '0') > 8) return false;
+            square += c - '0';
+            file += c - '0';
+        } else {
+            const int piece = PIECES[static_cast<unsigned char>(c)];
+            if (piece < 0 || file == 8) return false;
+            p.boards[piece] |= 1ull << square++;
+            ++file;
+        }
+    }
+    if (rank != 7 || file != 8) return false;
+
+    const std::string_view activeColor = nextField(fen, pos);
+    if (activeColor != "w" && activeColor != "b") return false;
+    p.sideToMove = activeColor == "w";
+
+    const std::string_view castling = nextField(fen, pos);
+    if (castling.empty()) return false;
+    if (castling != "-") {
+        for (char c : castling) {
+            const size_t right = std::string_view("KQkq").find(c);
+            if (right == std::string_view::npos || (p.castlingRights & (1u << right))) return false;
+            p.castlingRights |= static_cast<std::uint8_t>(1u << right);
+        }
+    }
+
+    const std::string_view enPassant = nextField(fen, pos);
+    if (enPassant != "-") {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' ||
+            (enPassant[1] != '3' && enPassant[1] != '6')) {
+            return false;
+        }
+        p.enPassant = static_cast<std::int8_t>(('8' - enPassant[1]) * 8 + (enPassant[0] - 'a'));
+    }
+
+    // Compteurs optionnels ; le texte qui les suit est ignoré (voir FENParser::toIndices)
+    const std::string_view halfmove = nextField(fen, pos);
+    if (!halfmove.empty()) {
+        if (!FENParser::parseCounter(halfmove, p.halfmoveClock)) return false;
+        const std::string_view fullmove = nextField(fen, pos);
+        if (!fullmove.empty() && !FENParser::parseCounter(fullmove, p.fullmoveNumber)) return false;
+    }
+
+    position = p;
+    return true;
+}
+
+bool Position::fromFeatures(std::span<const int> indices, Position& position) {
+    Position p;
+    p.sideToMove = false;
+    int squares = 0;
+    for (int idx : indices) {
+        if (idx < 0 || idx >= BOARD_FEATURES + 6) return false;
+        if (idx < BOARD_FEATURES) {
+            const int channel = idx % 13;
+            if (channel > 0) p.boards[channel - 1] |= 1ull << (idx / 13);
+            ++squares;
+        } else if (idx == BOARD_FEATURES) {
+            p.sideToMove = true;
+        } else if (idx < BOARD_FEATURES + 5) {
+            p.castlingRights |= static_cast<std::uint8_t>(1u << (idx - BOARD_FEATURES - 1));
+        } else {
+            p.enPassant = 64;
+        }
+    }
+    if (squares != 64) return false;
+    position = p;
+    return true;
+}
+
+std::string Position::toFen() const {
+    std::string fen;
+    for (int rank = 0; rank < 8; ++rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            const int channel = channelAt(rank * 8 + file);
+            if (channel == 0) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) fen += static_cast<char>('0' + empty);
+            empty = 0;
+            fen += PIECE_CHARS[channel - 1];
+        }
+        if (empty > 0) fen += static_cast<char>('0' + empty);
+        if (rank < 7) fen += '/';
+    }
+    fen += sideToMove ? " w " : " b ";
+    if (castlingRights == 0) fen += '-';
+    for (int r = 0; r < 4; ++r) {
+        if (castlingRights & (1u << r)) fen += "KQkq"[r];
+    }
+    if (enPassant >= 0 && enPassant < 64) {
+        fen += ' ';
+        fen += static_cast<char>('a' + enPassant % 8);
+        fen += static_cast<char>('8' - enPassant / 8);
+    } else {
+        fen += " -";
+    }
+    fen += ' ' + std::to_string(halfmoveClock) + ' ' + std::to_string(fullmoveNumber);
+    return fen;
+}
+
+std::uint64_t Position::white() const {
+    return boards[W_PAWN] | boards[W_KNIGHT] | boards[W_BISHOP] | boards[W_ROOK] | boards[W_QUEEN] | boards[W_KING];
+}
+
+std::uint64_t Position::black() const {
+    return boards[B_PAWN] | boards[B_KNIGHT] | boards[B_BISHOP] | boards[B_ROOK] | boards[B_QUEEN] | boards[B_KING];
+}
+
+int Position::channelAt(int square) const {
+    const std::uint64_t bit = 1ull << square;
+    for (int piece = 0; piece < PIECE_COUNT; ++piece) {
+        if (boards[piece] & bit) return piece + 1;
+    }
+    return 0;
+}
+
+std::uint64_t Position::key() const {
+    std::uint64_t h = 0;
+    for (int piece = 0; piece < PIECE_COUNT; ++piece) h = mix(h ^ boards[piece]) + piece;
+    const std::uint64_t state = (sideToMove ? 1u : 0u) | (castlingRights << 1) | (static_cast<std::uint64_t>(enPassant + 1) << 5);
+    return mix(h ^ state);
+}
+
+bool Position::operator==(const Position& other) const {
+    return boards == other.boards && sideToMove == other.sideToMove &&
+           castlingRights == other.castlingRights && enPassant == other.enPassant;
+}
+
+} // namespace analyzer
@@ -0,0 +1,73 @@
+#include "Prefetcher.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace analyzer {
+
+Prefetcher::Prefetcher(const DataSource& source, std::span<const std::size_t> rows, std::size_t batchSize, int depth)
+    : source(source), rows(rows), batchSize(std::max<std::size_t>(1, batchSize)), slots(std::max(1, depth)) {
+    batchCount = (rows.size() + this->batchSize - 1) / this->batchSize;
+    worker = std::thread(&Prefetcher::produce, this);
+}
+
+Prefetcher::Prefetcher(const DataSource& source, std::size_t begin, std::size_t end, std::size_t batchSize, int depth)
+    : source(source), range(std::max(begin, end) - begin), batchSize(std::max<std::size_t>(1, batchSize)),
+      slots(std::max(1, depth)) {
+    std::iota(range.begin(), range.end(), begin);
+    rows = range;
+    batchCount = (rows.size() + this->batchSize - 1) / this->batchSize;
+    worker = std::thread(&Prefetcher::produce, this);
+}
+
+Prefetcher::~Prefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    freed.notify_all();
+    worker.join();
+}
+
+void Prefetcher::produce() {
+    nn::trace::setThreadName("prefetcher");
+    for (std::size_t k = 0; k < batchCount; ++k) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            freed.wait(lock, [&] { return stopping || k - released < slots.size(); });
+            if (stopping) return;
+        }
+        // L'emplacement k % depth n'est lu par personne : encodage hors verrou
+        const std::size_t first = k * batchSize;
+        MYTORCH_TRACE_SCOPE("fill");
+        try {
+            source.fill(rows.subspan(first, std::min(batchSize, rows.size() - first)), slots[k % slots.size()]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            stopping = true;
+            ready.notify_all();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            produced++;
+        }
+        ready.notify_one();
+    }
+}
+
+const Minibatch* Prefetcher::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    // Le batch rendu au dernier appel est terminé
+    if (released < taken) {
+        released = taken;
+        freed.notify_one();
+    }
+    ready.wait(lock, [&] { return produced > taken || taken == batchCount || error; });
+    if (error) std::rethrow_exception(error);
+    if (taken == batchCount) return nullptr;
+    return &slots[taken++ % slots.size()];
+}
+
+} // namespace analyzer
@@ -0,0 +1,358 @@
+#include "Server.hpp"
+#include "SparseBatch.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace analyzer {
+
+namespace {
+
+const char* const LABELS[] = {"Nothing", "Check", "Checkmate"};
+
+[[noreturn]] void closeAndThrow(int fd, const std::string& message) {
+    if (fd >= 0) ::close(fd);
+    throw std::runtime_error(message);
+}
+
+} // namespace
+
+Server::Connection::~Connection() {
+    ::close(fd);
+}
+
+void Server::Connection::flush() {
+    size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t count = ::send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (count > 0) {
+            sent += count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            broken = true;
+            output.clear();
+            return;
+        }
+    }
+    output.erase(0, sent);
+}
+
+Server::Server(nn::Network& net, const Options& options)
+    : Server(&net, nullptr, net.layer(0).getInputSize(), options) {}
+
+Server::Server(nn::QuantizedNetwork& quantized, const Options& options)
+    : Server(nullptr, &quantized, quantized.inputSize(), options) {}
+
+Server::Server(nn::Network* net, nn::QuantizedNetwork* quantized, int inputSize, const Options& options)
+    : net(net), quantized(quantized), options(options) {
+    if (!FeatureExtractor::forInputSize(inputSize, features)) {
+        throw std::runtime_error("Model input size matches no feature set");
+    }
+    // Non bloquant : un réveil déjà en attente suffit, le thread de batch n'attend jamais le pipe
+    if (::pipe2(wakeFds, O_NONBLOCK) != 0) throw std::runtime_error("Cannot create wake-up pipe");
+}
+
+Server::~Server() {
+    ::close(wakeFds[0]);
+    ::close(wakeFds[1]);
+}
+
+int Server::openListener() {
+    int fd;
+    if (!options.socketPath.empty()) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (options.socketPath.size() >= sizeof(addr.sun_path)) throw std::runtime_error("Socket path too long");
+        std::strcpy(addr.sun_path, options.socketPath.c_str());
+        ::unlink(options.socketPath.c_str());
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            closeAndThrow(fd, "Cannot bind " + options.socketPath);
+        }
+    } else {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        if (fd >= 0) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            closeAndThrow(fd, "Cannot bind 127.0.0.1:" + std::to_string(options.port));
+        }
+    }
+    if (::listen(fd, 128) != 0) closeAndThrow(fd, "Cannot listen on server socket");
+    return fd;
+}
+
+int Server::connectTo(const Options& options) {
+    int fd;
+    if (!options.socketPath.empty()) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, options.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+    } else {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int noDelay = 1;
+        if (fd >= 0) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+    }
+    if (fd >= 0) ::close(fd);
+    return -1;
+}
+
+void Server::run() {
+    listenFd = openListener();
+    running = true;
+    listening = true;
+
+    std::thread batcher(&Server::batchLoop, this);
+    ioLoop();
+
+    listening = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    pending.notify_all();
+    batcher.join();
+
+    ::close(listenFd);
+    listenFd = -1;
+    if (!options.socketPath.empty()) ::unlink(options.socketPath.c_str());
+}
+
+void Server::stop() {
+    running = false;
+    wake();
+}
+
+void Server::wake() {
+    char byte = 0;
+    [[maybe_unused]] ssize_t written = ::write(wakeFds[1], &byte, 1);
+}
+
+// Plus aucune requête ne viendra de cette connexion : le batch n'a plus à l'attendre
+void Server::closeInput(Connection& connection) {
+    connection.reading = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        openConnections--;
+    }
+    pending.notify_one();
+}
+
+// Vrai quand une connexion qui ne lit plus n'a plus rien à recevoir. inFlight d'abord : à zéro
+// sans lecture, le thread de batch n'ajoutera plus de réponse.
+bool Server::finished(Connection& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (connection.inFlight > 0) return false;
+    }
+    std::lock_guard<std::mutex> lock(connection.writeMutex);
+    return connection.output.empty() || connection.broken;
+}
+
+void Server::ioLoop() {
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+
+    while (true) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeFds[0], POLLIN, 0});
+        for (const auto& c : connections) {
+            short events = 0;
+            std::lock_guard<std::mutex> lock(c->writeMutex);
+            if (!c->output.empty()) events |= POLLOUT;
+            if (c->reading && c->output.size() < MAX_PENDING_OUTPUT) events |= POLLIN;
+            fds.push_back({c->fd, events, 0});
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) continue; // EINTR
+        if (fds[1].revents) {
+            char drain[64];
+            while (::read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+            if (!running) break;
+        }
+
+        // Les connexions acceptées ici ne sont pas dans fds : parcours limité aux anciennes
+        const size_t polled = connections.size();
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd >= 0) {
+                connections.push_back(std::make_shared<Connection>(fd));
+                std::lock_guard<std::mutex> lock(mutex);
+                openConnections++;
+            }
+        }
+        std::vector<std::shared_ptr<Connection>> alive;
+        for (size_t i = 0; i < connections.size(); ++i) {
+            const auto& c = connections[i];
+            const short revents = i < polled ? fds[i + 2].revents : 0;
+            if (revents & POLLOUT) {
+                std::lock_guard<std::mutex> lock(c->writeMutex);
+                c->flush();
+            }
+            if (c->reading && (revents & (POLLIN | POLLHUP | POLLERR)) && !readFrom(c)) closeInput(*c);
+            if (!c->reading && (revents & (POLLHUP | POLLERR))) {
+                std::lock_guard<std::mutex> lock(c->writeMutex);  // Pair parti : réponses perdues
+                c->broken = true;
+                c->output.clear();
+            }
+            if (c->reading || !finished(*c)) alive.push_back(c);
+        }
+        connections.swap(alive);
+    }
+}
+
+// Lit ce qui est disponible et met en file les lignes complètes. false = plus rien à lire (fin
+// de flux, erreur, ou ligne sans '\n' au-delà de MAX_LINE_BYTES : la connexion est alors coupée).
+// La Connection reste ouverte tant que des requêtes en attente la référencent.
+bool Server::readFrom(const std::shared_ptr<Connection>& connection) {
+    char chunk[4096];
+    ssize_t received = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return true;
+    if (received <= 0) return false;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<Request> requests;
+    std::string& buffer = connection->buffer;
+    buffer.append(chunk, received);
+    size_t start = 0, end;
+    while ((end = buffer.find('\n', start)) != std::string::npos) {
+        std::string line = buffer.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        start = end + 1;
+        if (!line.empty()) requests.push_back({connection, std::move(line), now});
+    }
+    buffer.erase(0, start);
+    if (buffer.size() > MAX_LINE_BYTES) {
+        ::shutdown(connection->fd, SHUT_RDWR);
+        std::lock_guard<std::mutex> lock(connection->writeMutex);
+        connection->broken = true;
+        connection->output.clear();
+        return false;
+    }
+
+    if (!requests.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (connection->inFlight == 0) busyConnections++;
+            connection->inFlight += static_cast<int>(requests.size());
+            for (auto& r : requests) queue.push_back(std::move(r));
+        }
+        pending.notify_one();
+    }
+    return true;
+}
+
+void Server::batchLoop() {
+    const auto maxWait = std::chrono::microseconds(options.maxWaitMicros);
+    const size_t maxBatch = static_cast<size_t>(std::max(1, options.maxBatch));
+    std::vector<Request> batch;
+    int indices[FeatureExtractor::MAX_ACTIVE];
+    std::vector<char> valid;
+    nn::SparseBatch inputs;
+    std::string response;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            pending.wait(lock, [&] { return !queue.empty() || !running; });
+            if (queue.empty()) return;
+            // Attendre d'autres requêtes tant que le batch n'est pas plein et que la plus ancienne peut attendre
+            const auto deadline = queue.front().arrival + maxWait;
+            pending.wait_until(lock, deadline, [&] {
+                return queue.size() >= maxBatch || busyConnections >= openConnections || !running;
+            });
+
+            const size_t count = std::min(queue.size(), maxBatch);
+            batch.clear();
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+
+        inputs.clear(features.featureCount());
+        valid.clear();
+        for (const auto& r : batch) {
+            const int count = features.extract(r.fen, indices);
+            valid.push_back(count >= 0);
+            inputs.addRow(std::span<const int>(indices, std::max(count, 0)));
+        }
+        nn::Matrix outputs;
+        if (net) {
+            outputs = net->forwardBatch(inputs);
+        } else {
+            outputs = nn::Matrix(inputs.rows(), quantized->outputSize());
+            for (int b = 0; b < inputs.rows(); ++b) {
+                if (!valid[b]) continue;
+                const auto probs = quantized->infer(inputs.row(b));
+                std::copy(probs.begin(), probs.end(), outputs.row(b).begin());
+            }
+        }
+
+        // Réponses dans l'ordre de la file : l'ordre par connexion est conservé
+        for (size_t b = 0; b < batch.size(); ++b) {
+            if (!valid[b]) {
+                response = "Invalid\n";
+            } else {
+                auto probs = outputs.row(static_cast<int>(b));
+                int best = 0;
+                for (size_t k = 1; k < probs.size(); ++k) if (probs[k] > probs[best]) best = static_cast<int>(k);
+                response = best < 3 ? LABELS[best] : "Unknown";
+                for (nn::Scalar p : probs) {
+                    char number[32];
+                    int length = std::snprintf(number, sizeof(number), ",%.6g", static_cast<double>(p));
+                    response.append(number, length);
+                }
+                response += '\n';
+            }
+            Connection& connection = *batch[b].connection;
+            std::lock_guard<std::mutex> lock(connection.writeMutex);
+            if (!connection.broken) connection.output += response;
+        }
+        // Envoi sans attente ; ce qui reste (client lent, connexion à retirer) passe au thread d'E/S
+        bool handOff = false;
+        for (const auto& r : batch) {
+            {
+                std::lock_guard<std::mutex> lock(r.connection->writeMutex);
+                r.connection->flush();
+                handOff |= !r.connection->output.empty();
+            }
+            handOff |= !r.connection->reading;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& r : batch) {
+                if (--r.connection->inFlight == 0) busyConnections--;
+            }
+        }
+        if (handOff) wake();
+        batch.clear(); // Libère les connexions fermées entre-temps
+    }
+}
+
+} // namespace analyzer
@@ -1,5 +1,6 @@
 #include "Network.hpp"
 #include "CLI.hpp"
+#include "Utils.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -31,7 +32,7 @@ int main(int argc, char** argv) {
 
         // Set random seed if provided
         if (seed > 0) {
-            std::srand(seed);
+            nn::Utils::seed(seed);
             std::cout << "Using random seed: " << seed << std::endl;
         }
 
@@ -0,0 +1,121 @@
+#include "Server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Générateur de charge pour "my_torch_analyzer serve" : N clients en boucle fermée,
+// chacun envoie une FEN et attend la réponse avant la suivante.
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: my_torch_loadgen (--socket <path> | --port <n>) --input <fens.txt> [--clients N] [--requests N]" << std::endl;
+    std::cout << "  --clients: concurrent connections (default 8)" << std::endl;
+    std::cout << "  --requests: requests per client (default 1000)" << std::endl;
+}
+
+// Lit une ligne de réponse ; false si la connexion est fermée
+bool readLine(int fd, std::string& buffer, std::string& line) {
+    char chunk[512];
+    size_t pos;
+    while ((pos = buffer.find('\n')) == std::string::npos) {
+        ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+        buffer.append(chunk, received);
+    }
+    line = buffer.substr(0, pos);
+    buffer.erase(0, pos + 1);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    analyzer::Server::Options options;
+    std::string inputPath;
+    int clients = 8;
+    int requests = 1000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) options.socketPath = argv[++i];
+        else if (arg == "--port" && i + 1 < argc) options.port = std::atoi(argv[++i]);
+        else if (arg == "--input" && i + 1 < argc) inputPath = argv[++i];
+        else if (arg == "--clients" && i + 1 < argc) clients = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--requests" && i + 1 < argc) requests = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+    }
+    if (inputPath.empty() || (options.socketPath.empty() && options.port <= 0)) {
+        printUsage();
+        return 84;
+    }
+
+    std::vector<std::string> fens;
+    std::ifstream file(inputPath);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t sep = line.find(';');
+        if (sep != std::string::npos) line.resize(sep);
+        if (!line.empty()) fens.push_back(line + "\n");
+    }
+    if (fens.empty()) {
+        std::cerr << "Error: No FEN found in " << inputPath << std::endl;
+        return 84;
+    }
+
+    std::vector<std::vector<double>> latencies(clients);
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            int fd = analyzer::Server::connectTo(options);
+            if (fd < 0) {
+                failures++;
+                return;
+            }
+            std::string buffer, response;
+            latencies[c].reserve(requests);
+            for (int r = 0; r < requests; ++r) {
+                const std::string& fen = fens[(c * requests + r) % fens.size()];
+                const auto sent = std::chrono::steady_clock::now();
+                if (::send(fd, fen.data(), fen.size(), MSG_NOSIGNAL) != (ssize_t)fen.size() ||
+                    !readLine(fd, buffer, response)) {
+                    failures++;
+                    break;
+                }
+                latencies[c].push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - sent).count());
+            }
+            ::close(fd);
+        });
+    }
+    for (auto& t : threads) t.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    if (all.empty()) {
+        std::cerr << "Error: No request completed (" << failures << " failed connections)" << std::endl;
+        return 84;
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[std::min(all.size() - 1, (size_t)(p * all.size()))]; };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "requests: " << all.size() << " (" << failures << " failed), clients: " << clients << std::endl;
+    std::cout << "qps: " << all.size() / seconds << std::endl;
+    std::cout << "latency_us p50: " << percentile(0.50) << " p90: " << percentile(0.90)
+              << " p99: " << percentile(0.99) << " max: " << all.back() << std::endl;
+    return failures > 0 ? 1 : 0;
+}
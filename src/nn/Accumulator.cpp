@@ -0,0 +1,68 @@
+#include "Accumulator.hpp"
+#include "Kernels.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace nn {
+
+Accumulator::Accumulator(const Network& net) : net(&net) {
+    if (net.layerCount() == 0) throw std::invalid_argument("Accumulator needs a network with at least one layer");
+    const Layer& first = net.layer(0);
+    z = first.getBiases();
+    for (size_t l = 0; l < net.layerCount(); ++l) {
+        hidden.emplace_back(net.layer(l).getOutputSize());
+    }
+}
+
+void Accumulator::refresh(std::span<const int> active) {
+    const Layer& first = net->layer(0);
+    const auto& k = kernels::active<Scalar>();
+    z = first.getBiases();
+    for (int j : active) k.axpy(1, column(j), z.data(), (int)z.size());
+    updates = 0;
+}
+
+void Accumulator::add(int feature) {
+    const auto& k = kernels::active<Scalar>();
+    k.axpy(1, column(feature), z.data(), (int)z.size());
+    ++updates;
+}
+
+void Accumulator::remove(int feature) {
+    const auto& k = kernels::active<Scalar>();
+    k.axpy(-1, column(feature), z.data(), (int)z.size());
+    ++updates;
+}
+
+void Accumulator::update(std::span<const int> addedFeatures, std::span<const int> removedFeatures) {
+    for (int j : removedFeatures) remove(j);
+    for (int j : addedFeatures) add(j);
+}
+
+void Accumulator::transition(std::span<const int> before, std::span<const int> after) {
+    added.clear();
+    removed.clear();
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(removed));
+    update(added, removed);
+}
+
+const Scalar* Accumulator::column(int feature) const {
+    const Layer& first = net->layer(0);
+    if (static_cast<unsigned>(feature) >= static_cast<unsigned>(first.getInputSize())) {
+        throw std::out_of_range("Sparse feature index " + std::to_string(feature) + " out of range");
+    }
+    return first.column(feature).data();
+}
+
+std::span<const Scalar> Accumulator::evaluate() {
+    net->layer(0).activate(z.data(), hidden[0].data());
+    for (size_t l = 1; l < hidden.size(); ++l) {
+        net->layer(l).infer(hidden[l - 1].data(), hidden[l].data());
+    }
+    return hidden.back();
+}
+
+} // namespace nn
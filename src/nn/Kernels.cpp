@@ -0,0 +1,513 @@
+#include "Kernels.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MYTORCH_X86 1
+#endif
+
+namespace nn::kernels {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Référence scalaire (portable)
+// ---------------------------------------------------------------------------
+
+namespace scalar {
+
+template <typename T>
+T dot(const T* a, const T* b, int n) {
+    T sum = 0;
+    for (int j = 0; j < n; ++j) sum += a[j] * b[j];
+    return sum;
+}
+
+template <typename T>
+void dot4(const T* w, const T* const x[4], int n, T out[4]) {
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int j = 0; j < n; ++j) {
+        T wj = w[j];
+        s0 += wj * x[0][j];
+        s1 += wj * x[1][j];
+        s2 += wj * x[2][j];
+        s3 += wj * x[3][j];
+    }
+    out[0] = s0; out[1] = s1; out[2] = s2; out[3] = s3;
+}
+
+template <typename T>
+void axpy(T a, const T* x, T* y, int n) {
+    for (int j = 0; j < n; ++j) y[j] += a * x[j];
+}
+
+template <typename T>
+void axpy2(T a, const T* x, T* y, const T* u, T* v, int n) {
+    for (int j = 0; j < n; ++j) {
+        y[j] += a * x[j];
+        v[j] += a * u[j];
+    }
+}
+
+template <typename T>
+void axpy4(const T a[4], const T* const x[4], T* y, int n) {
+    for (int j = 0; j < n; ++j) {
+        y[j] += a[0] * x[0][j] + a[1] * x[1][j] + a[2] * x[2][j] + a[3] * x[3][j];
+    }
+}
+
+template <typename T>
+void sigmoid(const T* z, T* out, int n) {
+    for (int j = 0; j < n; ++j) out[j] = T(1) / (T(1) + fastExp(-z[j]));
+}
+
+template <typename T>
+void relu(const T* z, T* out, int n) {
+    for (int j = 0; j < n; ++j) out[j] = z[j] > 0 ? z[j] : T(0);
+}
+
+// Entiers : produits u8 x i8 accumulés en int32
+
+std::int32_t dotU8(const std::uint8_t* a, const std::int8_t* w, int n) {
+    std::int32_t sum = 0;
+    for (int j = 0; j < n; ++j) sum += a[j] * w[j];
+    return sum;
+}
+
+void dot4U8(const std::uint8_t* a, const std::int8_t* const w[4], int n, std::int32_t out[4]) {
+    for (int r = 0; r < 4; ++r) out[r] = dotU8(a, w[r], n);
+}
+
+void addColumn(const std::int8_t* column, std::int32_t* acc, int n) {
+    for (int j = 0; j < n; ++j) acc[j] += column[j];
+}
+
+} // namespace scalar
+
+#ifdef MYTORCH_X86
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA : 4 doubles / 8 floats par registre
+// ---------------------------------------------------------------------------
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+namespace avx2 {
+
+struct OpsD {
+    using T = double;
+    using V = __m256d;
+    static constexpr int WIDTH = 4;
+    static V zero() { return _mm256_setzero_pd(); }
+    static V set1(T a) { return _mm256_set1_pd(a); }
+    static V load(const T* p) { return _mm256_loadu_pd(p); }
+    static void store(T* p, V v) { _mm256_storeu_pd(p, v); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V shiftBits(V v, int s) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(v), s)); }
+    static T hsum(V v) {
+        __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+    }
+};
+
+struct OpsF {
+    using T = float;
+    using V = __m256;
+    static constexpr int WIDTH = 8;
+    static V zero() { return _mm256_setzero_ps(); }
+    static V set1(T a) { return _mm256_set1_ps(a); }
+    static V load(const T* p) { return _mm256_loadu_ps(p); }
+    static void store(T* p, V v) { _mm256_storeu_ps(p, v); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V shiftBits(V v, int s) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(v), s)); }
+    static T hsum(V v) {
+        __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+        return _mm_cvtss_f32(_mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1)));
+    }
+};
+
+#include "KernelsSimd.inl"
+
+// Entiers : pmaddubsw (paires u8 x i8 -> i16, sans saturation pour a <= 127) puis pmaddwd par 1 (-> i32)
+inline __m256i maddU8(__m256i a, __m256i w) {
+    return _mm256_madd_epi16(_mm256_maddubs_epi16(a, w), _mm256_set1_epi16(1));
+}
+
+inline __m128i fold(__m256i v) {
+    return _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+inline __m256i load8(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+
+std::int32_t dotU8(const std::uint8_t* a, const std::int8_t* w, int n) {
+    __m256i acc = _mm256_setzero_si256();
+    int j = 0;
+    for (; j + 32 <= n; j += 32) acc = _mm256_add_epi32(acc, maddU8(load8(a + j), load8(w + j)));
+    __m128i s = fold(acc);
+    s = _mm_hadd_epi32(s, s);
+    s = _mm_hadd_epi32(s, s);
+    return _mm_cvtsi128_si32(s) + scalar::dotU8(a + j, w + j, n - j);
+}
+
+void dot4U8(const std::uint8_t* a, const std::int8_t* const w[4], int n, std::int32_t out[4]) {
+    __m256i s0 = _mm256_setzero_si256(), s1 = s0, s2 = s0, s3 = s0;
+    int j = 0;
+    for (; j + 32 <= n; j += 32) {
+        const __m256i aj = load8(a + j);
+        s0 = _mm256_add_epi32(s0, maddU8(aj, load8(w[0] + j)));
+        s1 = _mm256_add_epi32(s1, maddU8(aj, load8(w[1] + j)));
+        s2 = _mm256_add_epi32(s2, maddU8(aj, load8(w[2] + j)));
+        s3 = _mm256_add_epi32(s3, maddU8(aj, load8(w[3] + j)));
+    }
+    // Les 4 réductions en une : out[r] = somme des voies de sr
+    const __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(fold(s0), fold(s1)), _mm_hadd_epi32(fold(s2), fold(s3)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sums);
+    for (int r = 0; r < 4; ++r) out[r] += scalar::dotU8(a + j, w[r] + j, n - j);
+}
+
+void addColumn(const std::int8_t* column, std::int32_t* acc, int n) {
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256i c = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(column + j)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j), _mm256_add_epi32(load8(acc + j), c));
+    }
+    scalar::addColumn(column + j, acc + j, n - j);
+}
+
+} // namespace avx2
+
+#pragma GCC pop_options
+
+// ---------------------------------------------------------------------------
+// AVX-512F : 8 doubles / 16 floats par registre
+// ---------------------------------------------------------------------------
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace avx512 {
+
+// _mm512_reduce_add_* déclenche un faux -Wuninitialized avec GCC 12 : réduction manuelle.
+// Même cause pour min, max et slli : variantes maskz avec un masque plein.
+struct OpsD {
+    using T = double;
+    using V = __m512d;
+    static constexpr int WIDTH = 8;
+    static V zero() { return _mm512_setzero_pd(); }
+    static V set1(T a) { return _mm512_set1_pd(a); }
+    static V load(const T* p) { return _mm512_loadu_pd(p); }
+    static void store(T* p, V v) { _mm512_storeu_pd(p, v); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V min(V a, V b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+    static V max(V a, V b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+    static V shiftBits(V v, int s) { return _mm512_castsi512_pd(_mm512_maskz_slli_epi64(0xFF, _mm512_castpd_si512(v), s)); }
+    static T hsum(V v) {
+        alignas(64) T lanes[WIDTH];
+        _mm512_store_pd(lanes, v);
+        T sum = 0;
+        for (T lane : lanes) sum += lane;
+        return sum;
+    }
+};
+
+struct OpsF {
+    using T = float;
+    using V = __m512;
+    static constexpr int WIDTH = 16;
+    static V zero() { return _mm512_setzero_ps(); }
+    static V set1(T a) { return _mm512_set1_ps(a); }
+    static V load(const T* p) { return _mm512_loadu_ps(p); }
+    static void store(T* p, V v) { _mm512_storeu_ps(p, v); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+    static V add(V a, V b) { return _mm512_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm512_div_ps(a, b); }
+    static V min(V a, V b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+    static V max(V a, V b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+    static V shiftBits(V v, int s) { return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, _mm512_castps_si512(v), s)); }
+    static T hsum(V v) {
+        alignas(64) T lanes[WIDTH];
+        _mm512_store_ps(lanes, v);
+        T sum = 0;
+        for (T lane : lanes) sum += lane;
+        return sum;
+    }
+};
+
+#include "KernelsSimd.inl"
+
+} // namespace avx512
+
+#pragma GCC pop_options
+
+// ---------------------------------------------------------------------------
+// Entiers AVX-512BW (pmaddubsw sur 64 octets) et VNNI (vpdpbusd : u8 x i8 -> i32 en une instruction)
+// ---------------------------------------------------------------------------
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+
+namespace avx512bw {
+
+// Formes maskz à masque plein : les formes simples passent par _mm512_undefined_*, que GCC 12
+// signale à tort comme non initialisé (même problème que _mm512_reduce_add_*)
+inline __m512i load16(const void* p) { return _mm512_loadu_si512(p); }
+
+inline __m128i fold(__m512i v) {
+    const __m256i half = _mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xFF, v, 0), _mm512_maskz_extracti64x4_epi64(0xFF, v, 1));
+    return _mm_add_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+}
+
+inline __m512i maddU8(__m512i a, __m512i w) {
+    return _mm512_madd_epi16(_mm512_maddubs_epi16(a, w), _mm512_set1_epi16(1));
+}
+
+std::int32_t dotU8(const std::uint8_t* a, const std::int8_t* w, int n) {
+    __m512i acc = _mm512_setzero_si512();
+    int j = 0;
+    for (; j + 64 <= n; j += 64) acc = _mm512_add_epi32(acc, maddU8(load16(a + j), load16(w + j)));
+    __m128i s = fold(acc);
+    s = _mm_hadd_epi32(s, s);
+    s = _mm_hadd_epi32(s, s);
+    return _mm_cvtsi128_si32(s) + scalar::dotU8(a + j, w + j, n - j);
+}
+
+void dot4U8(const std::uint8_t* a, const std::int8_t* const w[4], int n, std::int32_t out[4]) {
+    __m512i s0 = _mm512_setzero_si512(), s1 = s0, s2 = s0, s3 = s0;
+    int j = 0;
+    for (; j + 64 <= n; j += 64) {
+        const __m512i aj = load16(a + j);
+        s0 = _mm512_add_epi32(s0, maddU8(aj, load16(w[0] + j)));
+        s1 = _mm512_add_epi32(s1, maddU8(aj, load16(w[1] + j)));
+        s2 = _mm512_add_epi32(s2, maddU8(aj, load16(w[2] + j)));
+        s3 = _mm512_add_epi32(s3, maddU8(aj, load16(w[3] + j)));
+    }
+    const __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(fold(s0), fold(s1)), _mm_hadd_epi32(fold(s2), fold(s3)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sums);
+    for (int r = 0; r < 4; ++r) out[r] += scalar::dotU8(a + j, w[r] + j, n - j);
+}
+
+void addColumn(const std::int8_t* column, std::int32_t* acc, int n) {
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        const __m512i c = _mm512_maskz_cvtepi8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + j)));
+        _mm512_storeu_si512(acc + j, _mm512_add_epi32(load16(acc + j), c));
+    }
+    scalar::addColumn(column + j, acc + j, n - j);
+}
+
+} // namespace avx512bw
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512vnni")
+
+namespace vnni {
+
+std::int32_t dotU8(const std::uint8_t* a, const std::int8_t* w, int n) {
+    __m512i acc = _mm512_setzero_si512();
+    int j = 0;
+    for (; j + 64 <= n; j += 64) acc = _mm512_dpbusd_epi32(acc, avx512bw::load16(a + j), avx512bw::load16(w + j));
+    __m128i s = avx512bw::fold(acc);
+    s = _mm_hadd_epi32(s, s);
+    s = _mm_hadd_epi32(s, s);
+    return _mm_cvtsi128_si32(s) + scalar::dotU8(a + j, w + j, n - j);
+}
+
+void dot4U8(const std::uint8_t* a, const std::int8_t* const w[4], int n, std::int32_t out[4]) {
+    __m512i s0 = _mm512_setzero_si512(), s1 = s0, s2 = s0, s3 = s0;
+    int j = 0;
+    for (; j + 64 <= n; j += 64) {
+        const __m512i aj = avx512bw::load16(a + j);
+        s0 = _mm512_dpbusd_epi32(s0, aj, avx512bw::load16(w[0] + j));
+        s1 = _mm512_dpbusd_epi32(s1, aj, avx512bw::load16(w[1] + j));
+        s2 = _mm512_dpbusd_epi32(s2, aj, avx512bw::load16(w[2] + j));
+        s3 = _mm512_dpbusd_epi32(s3, aj, avx512bw::load16(w[3] + j));
+    }
+    const __m128i sums = _mm_hadd_epi32(_mm_hadd_epi32(avx512bw::fold(s0), avx512bw::fold(s1)),
+                                        _mm_hadd_epi32(avx512bw::fold(s2), avx512bw::fold(s3)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sums);
+    for (int r = 0; r < 4; ++r) out[r] += scalar::dotU8(a + j, w[r] + j, n - j);
+}
+
+} // namespace vnni
+
+#pragma GCC pop_options
+
+#endif // MYTORCH_X86
+
+template <typename T> struct Tables;
+
+template <> struct Tables<double> {
+    static constexpr KernelTable<double> SCALAR = {Isa::SCALAR, "scalar", scalar::dot<double>, scalar::dot4<double>,
+                                                   scalar::axpy<double>, scalar::axpy4<double>, scalar::axpy2<double>,
+                                                   scalar::sigmoid<double>,
+                                                   scalar::relu<double>};
+#ifdef MYTORCH_X86
+    static constexpr KernelTable<double> AVX2 = {Isa::AVX2, "avx2", avx2::dot<avx2::OpsD>, avx2::dot4<avx2::OpsD>,
+                                                 avx2::axpy<avx2::OpsD>, avx2::axpy4<avx2::OpsD>, avx2::axpy2<avx2::OpsD>,
+                                                 avx2::sigmoid<avx2::OpsD>,
+                                                 avx2::relu<avx2::OpsD>};
+    static constexpr KernelTable<double> AVX512 = {Isa::AVX512, "avx512", avx512::dot<avx512::OpsD>, avx512::dot4<avx512::OpsD>,
+                                                   avx512::axpy<avx512::OpsD>, avx512::axpy4<avx512::OpsD>, avx512::axpy2<avx512::OpsD>,
+                                                   avx512::sigmoid<avx512::OpsD>,
+                                                   avx512::relu<avx512::OpsD>};
+#endif
+};
+
+template <> struct Tables<float> {
+    static constexpr KernelTable<float> SCALAR = {Isa::SCALAR, "scalar", scalar::dot<float>, scalar::dot4<float>,
+                                                  scalar::axpy<float>, scalar::axpy4<float>, scalar::axpy2<float>,
+                                                  scalar::sigmoid<float>,
+                                                  scalar::relu<float>};
+#ifdef MYTORCH_X86
+    static constexpr KernelTable<float> AVX2 = {Isa::AVX2, "avx2", avx2::dot<avx2::OpsF>, avx2::dot4<avx2::OpsF>,
+                                                avx2::axpy<avx2::OpsF>, avx2::axpy4<avx2::OpsF>, avx2::axpy2<avx2::OpsF>,
+                                                avx2::sigmoid<avx2::OpsF>,
+                                                avx2::relu<avx2::OpsF>};
+    static constexpr KernelTable<float> AVX512 = {Isa::AVX512, "avx512", avx512::dot<avx512::OpsF>, avx512::dot4<avx512::OpsF>,
+                                                  avx512::axpy<avx512::OpsF>, avx512::axpy4<avx512::OpsF>, avx512::axpy2<avx512::OpsF>,
+                                                  avx512::sigmoid<avx512::OpsF>,
+                                                  avx512::relu<avx512::OpsF>};
+#endif
+};
+
+constexpr Int8KernelTable INT8_SCALAR = {Isa::SCALAR, "scalar", scalar::dotU8, scalar::dot4U8, scalar::addColumn};
+#ifdef MYTORCH_X86
+constexpr Int8KernelTable INT8_AVX2 = {Isa::AVX2, "avx2", avx2::dotU8, avx2::dot4U8, avx2::addColumn};
+constexpr Int8KernelTable INT8_AVX512 = {Isa::AVX512, "avx512bw", avx512bw::dotU8, avx512bw::dot4U8, avx512bw::addColumn};
+constexpr Int8KernelTable INT8_VNNI = {Isa::AVX512VNNI, "avx512vnni", vnni::dotU8, vnni::dot4U8, avx512bw::addColumn};
+#endif
+
+bool cpuSupports(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR:
+            return true;
+#ifdef MYTORCH_X86
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+        case Isa::AVX512VNNI:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512vnni");
+#endif
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+const KernelTable<T>& detect() {
+    const KernelTable<T>* best = forIsa<T>(Isa::SCALAR);
+    if (const KernelTable<T>* t = forIsa<T>(Isa::AVX2)) best = t;
+    if (const KernelTable<T>* t = forIsa<T>(Isa::AVX512)) best = t;
+
+    // Permet de forcer un chemin plus étroit (tests, comparaison de performances)
+    if (const char* forced = std::getenv("MYTORCH_ISA")) {
+        const KernelTable<T>* requested = nullptr;
+        if (std::strcmp(forced, "scalar") == 0) requested = forIsa<T>(Isa::SCALAR);
+        else if (std::strcmp(forced, "avx2") == 0) requested = forIsa<T>(Isa::AVX2);
+        else if (std::strcmp(forced, "avx512") == 0 || std::strcmp(forced, "vnni") == 0) requested = forIsa<T>(Isa::AVX512);
+
+        if (requested) best = requested;
+        else std::cerr << "Warning: MYTORCH_ISA=" << forced << " unavailable, using " << best->name << std::endl;
+    }
+    return *best;
+}
+
+const Int8KernelTable& detectInt8() {
+    const Int8KernelTable* best = int8ForIsa(Isa::SCALAR);
+    for (Isa isa : {Isa::AVX2, Isa::AVX512, Isa::AVX512VNNI}) {
+        if (const Int8KernelTable* t = int8ForIsa(isa)) best = t;
+    }
+
+    if (const char* forced = std::getenv("MYTORCH_ISA")) {
+        const Int8KernelTable* requested = nullptr;
+        if (std::strcmp(forced, "scalar") == 0) requested = int8ForIsa(Isa::SCALAR);
+        else if (std::strcmp(forced, "avx2") == 0) requested = int8ForIsa(Isa::AVX2);
+        else if (std::strcmp(forced, "avx512") == 0) requested = int8ForIsa(Isa::AVX512);
+        else if (std::strcmp(forced, "vnni") == 0) requested = int8ForIsa(Isa::AVX512VNNI);
+
+        if (requested) best = requested;
+        else std::cerr << "Warning: MYTORCH_ISA=" << forced << " unavailable for int8, using " << best->name << std::endl;
+    }
+    return *best;
+}
+
+} // namespace
+
+const Int8KernelTable* int8ForIsa(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR:
+            return &INT8_SCALAR;
+#ifdef MYTORCH_X86
+        case Isa::AVX2:
+            return cpuSupports(Isa::AVX2) ? &INT8_AVX2 : nullptr;
+        case Isa::AVX512:
+            return cpuSupports(Isa::AVX512) && __builtin_cpu_supports("avx512bw") ? &INT8_AVX512 : nullptr;
+        case Isa::AVX512VNNI:
+            return cpuSupports(Isa::AVX512VNNI) ? &INT8_VNNI : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const Int8KernelTable& activeInt8() {
+    static const Int8KernelTable& table = detectInt8();
+    return table;
+}
+
+template <typename T>
+const KernelTable<T>* forIsa(Isa isa) {
+    if (!cpuSupports(isa)) return nullptr;
+    switch (isa) {
+        case Isa::SCALAR:
+            return &Tables<T>::SCALAR;
+#ifdef MYTORCH_X86
+        case Isa::AVX2:
+            return &Tables<T>::AVX2;
+        case Isa::AVX512:
+            return &Tables<T>::AVX512;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+template <typename T>
+const KernelTable<T>& active() {
+    static const KernelTable<T>& table = detect<T>();
+    return table;
+}
+
+template const KernelTable<float>* forIsa<float>(Isa);
+template const KernelTable<double>* forIsa<double>(Isa);
+template const KernelTable<float>& active<float>();
+template const KernelTable<double>& active<double>();
+
+} // namespace nn::kernels
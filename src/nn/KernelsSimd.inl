@@ -0,0 +1,125 @@
+// Corps générique des noyaux SIMD, inclus une fois par jeu d'instructions
+// (voir Kernels.cpp) à l'intérieur d'une région #pragma GCC target.
+// Ops fournit : T, V, WIDTH, zero, set1, load, store, fmadd, add, sub, mul, div, min, max,
+// shiftBits (décalage à gauche des bits de chaque voie) et hsum.
+
+template <typename Ops>
+typename Ops::T dot(const typename Ops::T* a, const typename Ops::T* b, int n) {
+    constexpr int W = Ops::WIDTH;
+    auto acc0 = Ops::zero(), acc1 = Ops::zero();
+    int j = 0;
+    for (; j + 2 * W <= n; j += 2 * W) {
+        acc0 = Ops::fmadd(Ops::load(a + j), Ops::load(b + j), acc0);
+        acc1 = Ops::fmadd(Ops::load(a + j + W), Ops::load(b + j + W), acc1);
+    }
+    for (; j + W <= n; j += W) {
+        acc0 = Ops::fmadd(Ops::load(a + j), Ops::load(b + j), acc0);
+    }
+    typename Ops::T sum = Ops::hsum(Ops::add(acc0, acc1));
+    for (; j < n; ++j) sum += a[j] * b[j];
+    return sum;
+}
+
+template <typename Ops>
+void dot4(const typename Ops::T* w, const typename Ops::T* const x[4], int n, typename Ops::T out[4]) {
+    constexpr int W = Ops::WIDTH;
+    auto s0 = Ops::zero(), s1 = Ops::zero(), s2 = Ops::zero(), s3 = Ops::zero();
+    int j = 0;
+    for (; j + W <= n; j += W) {
+        auto wj = Ops::load(w + j);
+        s0 = Ops::fmadd(wj, Ops::load(x[0] + j), s0);
+        s1 = Ops::fmadd(wj, Ops::load(x[1] + j), s1);
+        s2 = Ops::fmadd(wj, Ops::load(x[2] + j), s2);
+        s3 = Ops::fmadd(wj, Ops::load(x[3] + j), s3);
+    }
+    out[0] = Ops::hsum(s0); out[1] = Ops::hsum(s1); out[2] = Ops::hsum(s2); out[3] = Ops::hsum(s3);
+    for (; j < n; ++j) {
+        for (int k = 0; k < 4; ++k) out[k] += w[j] * x[k][j];
+    }
+}
+
+template <typename Ops>
+void axpy(typename Ops::T a, const typename Ops::T* x, typename Ops::T* y, int n) {
+    constexpr int W = Ops::WIDTH;
+    auto va = Ops::set1(a);
+    int j = 0;
+    for (; j + W <= n; j += W) {
+        Ops::store(y + j, Ops::fmadd(va, Ops::load(x + j), Ops::load(y + j)));
+    }
+    for (; j < n; ++j) y[j] += a * x[j];
+}
+
+template <typename Ops>
+void axpy2(typename Ops::T a, const typename Ops::T* x, typename Ops::T* y,
+           const typename Ops::T* u, typename Ops::T* v, int n) {
+    constexpr int W = Ops::WIDTH;
+    auto va = Ops::set1(a);
+    int j = 0;
+    for (; j + W <= n; j += W) {
+        Ops::store(y + j, Ops::fmadd(va, Ops::load(x + j), Ops::load(y + j)));
+        Ops::store(v + j, Ops::fmadd(va, Ops::load(u + j), Ops::load(v + j)));
+    }
+    for (; j < n; ++j) {
+        y[j] += a * x[j];
+        v[j] += a * u[j];
+    }
+}
+
+template <typename Ops>
+void axpy4(const typename Ops::T a[4], const typename Ops::T* const x[4], typename Ops::T* y, int n) {
+    constexpr int W = Ops::WIDTH;
+    auto a0 = Ops::set1(a[0]), a1 = Ops::set1(a[1]), a2 = Ops::set1(a[2]), a3 = Ops::set1(a[3]);
+    int j = 0;
+    for (; j + W <= n; j += W) {
+        auto acc = Ops::load(y + j);
+        acc = Ops::fmadd(a0, Ops::load(x[0] + j), acc);
+        acc = Ops::fmadd(a1, Ops::load(x[1] + j), acc);
+        acc = Ops::fmadd(a2, Ops::load(x[2] + j), acc);
+        acc = Ops::fmadd(a3, Ops::load(x[3] + j), acc);
+        Ops::store(y + j, acc);
+    }
+    for (; j < n; ++j) {
+        y[j] += a[0] * x[0][j] + a[1] * x[1][j] + a[2] * x[2][j] + a[3] * x[3][j];
+    }
+}
+
+// fastExp sur un registre, même schéma que la référence scalaire de Kernels.hpp
+template <typename Ops>
+typename Ops::V expApprox(typename Ops::V x) {
+    using T = typename Ops::T;
+    using E = ExpApprox<T>;
+    using C = ExpCoefficients<T>;
+    x = Ops::min(Ops::max(x, Ops::set1(E::LO)), Ops::set1(E::HI));
+    const auto round = Ops::set1(C::ROUND);
+    const auto n = Ops::sub(Ops::fmadd(x, Ops::set1(C::LOG2E), round), round);
+    auto r = Ops::fmadd(n, Ops::set1(-E::LN2_HI), x);
+    r = Ops::fmadd(n, Ops::set1(-E::LN2_LO), r);
+    auto p = Ops::set1(C::TAYLOR[E::DEGREE]);
+    for (int k = E::DEGREE - 1; k >= 0; --k) p = Ops::fmadd(p, r, Ops::set1(C::TAYLOR[k]));
+    const auto scale = Ops::shiftBits(Ops::add(n, Ops::set1(C::ROUND + E::BIAS)), E::MANTISSA);
+    return Ops::mul(p, scale);
+}
+
+template <typename Ops>
+typename Ops::V sigmoid(typename Ops::V z) {
+    const auto one = Ops::set1(typename Ops::T(1));
+    return Ops::div(one, Ops::add(one, expApprox<Ops>(Ops::sub(Ops::zero(), z))));
+}
+
+// Reste scalaire par libm : un chargement vectoriel de valeurs tout juste écrites une à une (cas
+// d'une couche de sortie de 3 neurones) bloque la redirection store -> load et coûte plus cher
+template <typename Ops>
+void sigmoid(const typename Ops::T* z, typename Ops::T* out, int n) {
+    constexpr int W = Ops::WIDTH;
+    int j = 0;
+    for (; j + W <= n; j += W) Ops::store(out + j, sigmoid<Ops>(Ops::load(z + j)));
+    for (; j < n; ++j) out[j] = typename Ops::T(1) / (typename Ops::T(1) + std::exp(-z[j]));
+}
+
+template <typename Ops>
+void relu(const typename Ops::T* z, typename Ops::T* out, int n) {
+    constexpr int W = Ops::WIDTH;
+    int j = 0;
+    for (; j + W <= n; j += W) Ops::store(out + j, Ops::max(Ops::load(z + j), Ops::zero()));
+    for (; j < n; ++j) out[j] = z[j] > 0 ? z[j] : typename Ops::T(0);
+}
@@ -1,164 +1,436 @@
 #include "Layer.hpp"
 #include "Utils.hpp"
-#include "Activations.hpp"
+#include "Kernels.hpp"
+#include "Optimizer.hpp"
 #include <random>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 namespace nn {
 
-Layer::Layer(int inputSize, int outputSize, ActivationType type)
-    : inputSize(inputSize), outputSize(outputSize), activationType(type) {
+namespace {
 
-    weights.resize(outputSize, std::vector<double>(inputSize));
+// Nombre de lignes de W traitées ensemble : ~4 lignes de 838 doubles restent en L1
+constexpr int ROW_BLOCK = 4;
+
+// Côté des tuiles pour la transposition W -> W^T
+constexpr int TILE = 16;
+
+} // namespace
+
+Layer::Layer(int inputSize, int outputSize, ActivationType type, bool sparseInput)
+    : inputSize(inputSize), outputSize(outputSize), activationType(type), sparseInput(sparseInput) {
+
+    if (sparseInput) weights.resize(inputSize, outputSize);
+    else weights.resize(outputSize, inputSize);
     biases.resize(outputSize);
-    grad_weights_sum.resize(outputSize, std::vector<double>(inputSize, 0.0));
-    grad_biases_sum.resize(outputSize, 0.0);
 
+    // Même ordre de tirage dans les deux dispositions : une graine donne les mêmes poids
     double limit = sqrt(6.0 / (inputSize + outputSize));
     for (int i = 0; i < outputSize; ++i) {
         biases[i] = 0.1;
         for (int j = 0; j < inputSize; ++j) {
-            weights[i][j] = Utils::randomWeight(-limit, limit);
+            at(i, j) = Utils::randomWeight(-limit, limit);
         }
     }
 }
 
-std::vector<double> Layer::forward(const std::vector<double>& input) {
-    last_input = input;
-    last_pre_activation.resize(outputSize);
-    std::vector<double> output(outputSize);
+Layer::Layer(Matrix weights, std::vector<Scalar> biases, ActivationType type, bool sparseInput)
+    : inputSize(sparseInput ? weights.rows() : weights.cols()), outputSize(sparseInput ? weights.cols() : weights.rows()),
+      activationType(type), sparseInput(sparseInput), weights(std::move(weights)), biases(std::move(biases)) {}
 
-    // Calculer z = Wx + b
-    for (int i = 0; i < outputSize; ++i) {
-        double sum = biases[i];
+void Layer::enableSparseInput() {
+    if (sparseInput) return;
+    Matrix transposed(inputSize, outputSize);
+    // Par tuiles pour que lectures et écritures restent en L1
+    for (int i0 = 0; i0 < outputSize; i0 += TILE) {
+        for (int j0 = 0; j0 < inputSize; j0 += TILE) {
+            for (int i = i0; i < std::min(i0 + TILE, outputSize); ++i) {
+                for (int j = j0; j < std::min(j0 + TILE, inputSize); ++j) transposed(j, i) = weights(i, j);
+            }
+        }
+    }
+    weights = std::move(transposed);
+    sparseInput = true;
+    gradients = LayerGradients();                 // Forme des poids changée : réalloué au besoin
+}
+
+void Layer::ensureGradients() {
+    if (gradients.grad_biases_sum.empty()) gradients = makeGradients();
+}
+
+std::vector<Scalar> Layer::forward(const std::vector<Scalar>& input) {
+    // assign() réutilise la capacité : pas d'allocation d'un appel à l'autre hors valeur de retour
+    last_input.assign(input.begin(), input.end());
+    last_output.resize(outputSize);
+    infer(input.data(), last_output.data());
+    return last_output;
+}
+
+std::vector<Scalar> Layer::backward(const std::vector<Scalar>& grad_output, double learningRate) {
+    std::vector<Scalar> grad_input(inputSize, 0.0);
+    std::vector<Scalar> dZ(outputSize);
+    computeDeltas(grad_output.data(), last_output.data(), dZ.data());
+
+    const auto& k = kernels::active<Scalar>();
+    if (sparseInput) {
         for (int j = 0; j < inputSize; ++j) {
-            sum += weights[i][j] * input[j];
+            Scalar* w = weights.row(j).data();
+            grad_input[j] = k.dot(w, dZ.data(), outputSize);
+            if (last_input[j] != 0) k.axpy(-learningRate * last_input[j], dZ.data(), w, outputSize);
         }
-        last_pre_activation[i] = sum;
+        for (int i = 0; i < outputSize; ++i) biases[i] -= learningRate * dZ[i];
+        return grad_input;
+    }
+    for (int i = 0; i < outputSize; ++i) {
+        Scalar* w = weights.row(i).data();
+        k.axpy(dZ[i], w, grad_input.data(), inputSize);
+        k.axpy(-learningRate * dZ[i], last_input.data(), w, inputSize);
+        biases[i] -= learningRate * dZ[i];
     }
+    return grad_input;
+}
 
-    if (activationType == ActivationType::SOFTMAX) {
-        output = Activations::softmax(last_pre_activation);
-    } else {
-        for (int i = 0; i < outputSize; ++i) {
-            output[i] = (activationType == ActivationType::RELU)
-                        ? Activations::relu(last_pre_activation[i])
-                        : Activations::sigmoid(last_pre_activation[i]);
+std::vector<Scalar> Layer::backward(const std::vector<Scalar>& grad_output) {
+    std::vector<Scalar> grad_input(inputSize, 0.0);
+    std::vector<Scalar> dZ(outputSize);
+    computeDeltas(grad_output.data(), last_output.data(), dZ.data());
+
+    const auto& k = kernels::active<Scalar>();
+    if (sparseInput) {
+        for (int j = 0; j < inputSize; ++j) grad_input[j] = k.dot(weights.row(j).data(), dZ.data(), outputSize);
+        return grad_input;
+    }
+    for (int i = 0; i < outputSize; ++i) {
+        k.axpy(dZ[i], weights.row(i).data(), grad_input.data(), inputSize);
+    }
+    return grad_input;
+}
+
+void Layer::accumulateGradients(const std::vector<Scalar>& grad_output) {
+    backwardFused(grad_output.data(), nullptr);
+}
+
+void Layer::backwardFused(const Scalar* grad_output, Scalar* grad_input) {
+    ensureGradients();
+    last_deltas.resize(outputSize);
+    computeDeltas(grad_output, last_output.data(), last_deltas.data());
+    if (grad_input) std::fill(grad_input, grad_input + inputSize, Scalar(0));
+
+    const auto& k = kernels::active<Scalar>();
+    const Scalar* x = last_input.data();
+    if (sparseInput) {
+        // Ligne j de W^T lue une seule fois pour dX[j] et dW^T[j] += x[j] * dZ
+        const Scalar* d = last_deltas.data();
+        for (int i = 0; i < outputSize; ++i) gradients.grad_biases_sum[i] += d[i];
+        for (int j = 0; j < inputSize; ++j) {
+            if (grad_input) grad_input[j] = k.dot(weights.row(j).data(), d, outputSize);
+            if (x[j] != 0) k.axpy(x[j], d, gradients.grad_weights_sum.row(j).data(), outputSize);
         }
+        return;
+    }
+    for (int i = 0; i < outputSize; ++i) {
+        const Scalar d = last_deltas[i];
+        if (d == 0) continue; // Neurone ReLU inactif : ni dW ni dX
+        gradients.grad_biases_sum[i] += d;
+        Scalar* gw = gradients.grad_weights_sum.row(i).data();
+        // Ligne i de W lue une seule fois pour dW[i] += d * x et dX += d * W[i]
+        if (grad_input) k.axpy2(d, x, gw, weights.row(i).data(), grad_input, inputSize);
+        else k.axpy(d, x, gw, inputSize);
     }
+}
 
-    last_output = output;  // Stocker pour Softmax
-    return output;
+void Layer::activate(const Scalar* z, Scalar* out) const {
+    const auto& k = kernels::active<Scalar>();
+    withActivation(activationType, [&](auto act) { act.apply(k, z, out, outputSize); });
 }
 
-std::vector<double> Layer::backward(const std::vector<double>& grad_output, double learningRate) {
-    std::vector<double> grad_input(inputSize, 0.0);
-    std::vector<double> dZ(outputSize);
+void Layer::activateRows(Matrix& z) const {
+    const auto& k = kernels::active<Scalar>();
+    withActivation(activationType, [&](auto act) {
+        for (int b = 0; b < z.rows(); ++b) act.apply(k, z.row(b).data(), z.row(b).data(), outputSize);
+    });
+}
 
-    if (activationType == ActivationType::SOFTMAX) {
-        dZ = grad_output;
+void Layer::infer(const Scalar* input, Scalar* output) const {
+    const auto& k = kernels::active<Scalar>();
+    if (sparseInput) {
+        std::copy(biases.begin(), biases.end(), output);
+        for (int j = 0; j < inputSize; ++j) {
+            if (input[j] != 0) k.axpy(input[j], weights.row(j).data(), output, outputSize);
+        }
     } else {
         for (int i = 0; i < outputSize; ++i) {
-            double deriv = (activationType == ActivationType::RELU)
-                           ? Activations::reluDerivative(last_pre_activation[i])
-                           : Activations::sigmoidDerivative(last_pre_activation[i]);
-            dZ[i] = grad_output[i] * deriv;
+            output[i] = biases[i] + k.dot(weights.row(i).data(), input, inputSize);
         }
     }
+    activate(output, output);
+}
 
-    for (int i = 0; i < outputSize; ++i) {
-        for (int j = 0; j < inputSize; ++j) {
-            grad_input[j] += weights[i][j] * dZ[i];
-            weights[i][j] -= learningRate * dZ[i] * last_input[j];
+void Layer::infer(std::span<const int> active, Scalar* output) const {
+    requireSparseInput(inputSize);
+    const auto& k = kernels::active<Scalar>();
+    std::copy(biases.begin(), biases.end(), output);
+    for (int j : active) {
+        if (static_cast<unsigned>(j) >= static_cast<unsigned>(inputSize)) {
+            throw std::out_of_range("Sparse feature index " + std::to_string(j) + " out of range");
         }
-        biases[i] -= learningRate * dZ[i];
+        k.axpy(1, weights.row(j).data(), output, outputSize);
     }
-    return grad_input;
+    activate(output, output);
 }
 
-std::vector<double> Layer::backward(const std::vector<double>& grad_output) {
-    std::vector<double> grad_input(inputSize, 0.0);
-    std::vector<double> dZ(outputSize);
+void Layer::requireSparseInput(int features) const {
+    if (!sparseInput) throw std::invalid_argument("Layer was not built for sparse input");
+    if (features != inputSize) {
+        throw std::invalid_argument("Sparse input has " + std::to_string(features) + " features, layer expects " +
+                                    std::to_string(inputSize));
+    }
+}
 
-    //  Gérer Softmax
-    if (activationType == ActivationType::SOFTMAX) {
-        dZ = grad_output;
-    } else {
-        for (int i = 0; i < outputSize; ++i) {
-            double deriv = (activationType == ActivationType::RELU)
-                           ? Activations::reluDerivative(last_pre_activation[i])
-                           : Activations::sigmoidDerivative(last_pre_activation[i]);
-            dZ[i] = grad_output[i] * deriv;
+void Layer::computeDeltas(const Scalar* grad_output, const Scalar* y, Scalar* dZ) const {
+    withActivation(activationType, [&](auto act) { act.delta(grad_output, y, dZ, outputSize); });
+}
+
+Matrix Layer::forwardBatch(const Matrix& input) {
+    batch_input = input;
+    return forwardBatch(batch_input, batch_cache);
+}
+
+Matrix Layer::forwardBatch(const SparseBatch& input) {
+    batch_sparse_input = input;
+    return forwardBatch(batch_sparse_input, batch_cache);
+}
+
+Matrix Layer::backwardBatch(const Matrix& grad_output, bool inputGradient) {
+    ensureGradients();
+    return backwardBatch(grad_output, batch_cache, gradients, inputGradient);
+}
+
+const Matrix& Layer::forwardBatch(const Matrix& input, LayerCache& cache) const {
+    const auto& k = kernels::active<Scalar>();
+    const int batchSize = input.rows();
+    cache.input = &input;
+    cache.sparse_input = nullptr;
+    cache.output.resize(batchSize, outputSize);
+    Matrix& z = cache.output;
+
+    if (sparseInput) {
+        // Z[b] = B + somme des x[b][j] * W^T[j] : les entrées nulles ne coûtent rien
+        for (int b = 0; b < batchSize; ++b) {
+            Scalar* zb = z.row(b).data();
+            const Scalar* x = input.row(b).data();
+            std::copy(biases.begin(), biases.end(), zb);
+            for (int j = 0; j < inputSize; ++j) {
+                if (x[j] != 0) k.axpy(x[j], weights.row(j).data(), zb, outputSize);
+            }
         }
+        activateRows(z);
+        return cache.output;
     }
 
-    for (int i = 0; i < outputSize; ++i) {
-        for (int j = 0; j < inputSize; ++j) {
-            grad_input[j] += weights[i][j] * dZ[i];
+    // Z = X * W^T + B, par blocs de lignes de W pour réutiliser chaque poids sur tout le batch
+    for (int i0 = 0; i0 < outputSize; i0 += ROW_BLOCK) {
+        const int i1 = std::min(i0 + ROW_BLOCK, outputSize);
+        int b = 0;
+        for (; b + 4 <= batchSize; b += 4) {
+            for (int i = i0; i < i1; ++i) {
+                const Scalar* x[4] = {input.row(b).data(), input.row(b + 1).data(),
+                                      input.row(b + 2).data(), input.row(b + 3).data()};
+                Scalar out[4];
+                k.dot4(weights.row(i).data(), x, inputSize, out);
+                for (int r = 0; r < 4; ++r) z(b + r, i) = out[r] + biases[i];
+            }
+        }
+        for (; b < batchSize; ++b) {
+            for (int i = i0; i < i1; ++i) {
+                z(b, i) = k.dot(weights.row(i).data(), input.row(b).data(), inputSize) + biases[i];
+            }
         }
     }
-    return grad_input;
+
+    activateRows(z);
+    return cache.output;
 }
 
-void Layer::accumulateGradients(const std::vector<double>& grad_output) {
-    std::vector<double> dZ(outputSize);
+const Matrix& Layer::forwardBatch(const SparseBatch& input, LayerCache& cache) const {
+    requireSparseInput(input.cols());             // Indices déjà bornés par SparseBatch::addRow
+    const int batchSize = input.rows();
+    cache.input = nullptr;
+    cache.sparse_input = &input;
+    cache.output.resize(batchSize, outputSize);
+    Matrix& z = cache.output;
 
+    // Z[b] = B + somme des colonnes actives de W, lues comme lignes contiguës de W^T
+    const auto& k = kernels::active<Scalar>();
+    for (int b = 0; b < batchSize; ++b) {
+        Scalar* zb = z.row(b).data();
+        std::copy(biases.begin(), biases.end(), zb);
+        auto idx = input.row(b);
+        size_t n = 0;
+        for (; n + 4 <= idx.size(); n += 4) {
+            static constexpr Scalar ONES[4] = {1, 1, 1, 1};
+            const Scalar* cols[4] = {weights.row(idx[n]).data(), weights.row(idx[n + 1]).data(),
+                                     weights.row(idx[n + 2]).data(), weights.row(idx[n + 3]).data()};
+            k.axpy4(ONES, cols, zb, outputSize);
+        }
+        for (; n < idx.size(); ++n) k.axpy(1, weights.row(idx[n]).data(), zb, outputSize);
+    }
 
-    if (activationType == ActivationType::SOFTMAX) {
-        dZ = grad_output;
-    } else {
-        for (int i = 0; i < outputSize; ++i) {
-            double deriv = (activationType == ActivationType::RELU)
-                           ? Activations::reluDerivative(last_pre_activation[i])
-                           : Activations::sigmoidDerivative(last_pre_activation[i]);
-            dZ[i] = grad_output[i] * deriv;
+    activateRows(z);
+    return cache.output;
+}
+
+const Matrix& Layer::backwardBatch(const Matrix& grad_output, LayerCache& cache, LayerGradients& grads,
+                                   bool inputGradient) const {
+    const auto& k = kernels::active<Scalar>();
+    const int batchSize = grad_output.rows();
+    Matrix& dZ = cache.deltas;
+    dZ.resize(batchSize, outputSize);
+    withActivation(activationType, [&](auto act) {
+        for (int b = 0; b < batchSize; ++b) {
+            act.delta(grad_output.row(b).data(), cache.output.row(b).data(), dZ.row(b).data(), outputSize);
+        }
+    });
+
+    if (sparseInput) {
+        // dW^T[j] += x[b][j] * dZ[b] pour les seules entrées non nulles j de l'échantillon b
+        Matrix& gw = grads.grad_weights_sum;
+        for (int b = 0; b < batchSize; ++b) {
+            const Scalar* d = dZ.row(b).data();
+            if (cache.sparse_input) {
+                for (int j : cache.sparse_input->row(b)) k.axpy(1, d, gw.row(j).data(), outputSize);
+            } else {
+                const Scalar* x = cache.input->row(b).data();
+                for (int j = 0; j < inputSize; ++j) {
+                    if (x[j] != 0) k.axpy(x[j], d, gw.row(j).data(), outputSize);
+                }
+            }
+            for (int i = 0; i < outputSize; ++i) grads.grad_biases_sum[i] += d[i];
+        }
+        // L'entrée creuse n'est pas différentiable
+        if (!inputGradient || cache.sparse_input) {
+            cache.grad_input.resize(0, 0);
+            return cache.grad_input;
+        }
+        cache.grad_input.resize(batchSize, inputSize);
+        for (int b = 0; b < batchSize; ++b) {
+            Scalar* gx = cache.grad_input.row(b).data();
+            for (int j = 0; j < inputSize; ++j) gx[j] = k.dot(weights.row(j).data(), dZ.row(b).data(), outputSize);
         }
+        return cache.grad_input;
     }
 
+    const Matrix& input = *cache.input;
+
+    // dW += dZ^T * X : 4 échantillons par passage sur la ligne de gradient
     for (int i = 0; i < outputSize; ++i) {
-        grad_biases_sum[i] += dZ[i];
-        for (int j = 0; j < inputSize; ++j) {
-            grad_weights_sum[i][j] += dZ[i] * last_input[j];
+        Scalar* gw = grads.grad_weights_sum.row(i).data();
+        int b = 0;
+        for (; b + 4 <= batchSize; b += 4) {
+            const Scalar a[4] = {dZ(b, i), dZ(b + 1, i), dZ(b + 2, i), dZ(b + 3, i)};
+            const Scalar* x[4] = {input.row(b).data(), input.row(b + 1).data(),
+                                  input.row(b + 2).data(), input.row(b + 3).data()};
+            k.axpy4(a, x, gw, inputSize);
+            grads.grad_biases_sum[i] += a[0] + a[1] + a[2] + a[3];
+        }
+        for (; b < batchSize; ++b) {
+            k.axpy(dZ(b, i), input.row(b).data(), gw, inputSize);
+            grads.grad_biases_sum[i] += dZ(b, i);
         }
     }
+
+    if (!inputGradient) {
+        cache.grad_input.resize(0, 0);
+        return cache.grad_input;
+    }
+
+    // dX = dZ * W : chaque bloc de 4 lignes de W reste en cache pendant tout le batch
+    Matrix& grad_input = cache.grad_input;
+    grad_input.resize(batchSize, inputSize);
+    int i = 0;
+    for (; i + 4 <= outputSize; i += 4) {
+        const Scalar* w[4] = {weights.row(i).data(), weights.row(i + 1).data(),
+                              weights.row(i + 2).data(), weights.row(i + 3).data()};
+        for (int b = 0; b < batchSize; ++b) {
+            const Scalar a[4] = {dZ(b, i), dZ(b, i + 1), dZ(b, i + 2), dZ(b, i + 3)};
+            k.axpy4(a, w, grad_input.row(b).data(), inputSize);
+        }
+    }
+    for (; i < outputSize; ++i) {
+        for (int b = 0; b < batchSize; ++b) {
+            k.axpy(dZ(b, i), weights.row(i).data(), grad_input.row(b).data(), inputSize);
+        }
+    }
+    return grad_input;
+}
+
+LayerGradients Layer::makeGradients() const {
+    LayerGradients grads;
+    grads.grad_weights_sum.resize(weights.rows(), weights.cols());
+    grads.grad_biases_sum.assign(outputSize, 0.0);
+    return grads;
 }
 
 void Layer::updateWeights(double learningRate, int batchSize) {
+    if (gradients.grad_biases_sum.empty()) return;
+    applyGradients(gradients, learningRate, batchSize);
+    gradients.clear();
+}
+
+void Layer::applyGradients(const LayerGradients& grads, double learningRate, int batchSize) {
     if (batchSize == 0) return;
-    double scale = learningRate / batchSize;
+    Scalar scale = learningRate / batchSize;
 
-    for (int i = 0; i < outputSize; ++i) {
-        biases[i] -= grad_biases_sum[i] * scale;
-        grad_biases_sum[i] = 0.0;
-        for (int j = 0; j < inputSize; ++j) {
-            weights[i][j] -= grad_weights_sum[i][j] * scale;
-            grad_weights_sum[i][j] = 0.0;
-        }
+    // Gradient et poids ont la même disposition : une passe contiguë, quelle qu'elle soit
+    const auto& k = kernels::active<Scalar>();
+    for (int r = 0; r < weights.rows(); ++r) {
+        k.axpy(-scale, grads.grad_weights_sum.row(r).data(), weights.row(r).data(), weights.cols());
     }
+    for (int i = 0; i < outputSize; ++i) biases[i] -= grads.grad_biases_sum[i] * scale;
 }
 
-void Layer::clearGradients() {
-    for (int i = 0; i < outputSize; ++i) {
-        grad_biases_sum[i] = 0.0;
-        std::fill(grad_weights_sum[i].begin(), grad_weights_sum[i].end(), 0.0);
+void Layer::applyGradients(const LayerGradients& grads, double learningRate, int batchSize,
+                           Optimizer& optimizer, std::size_t index) {
+    const OptimizerOptions& options = optimizer.options();
+    if (options.type == OptimizerType::SGD && options.weightDecay == 0) {
+        applyGradients(grads, learningRate, batchSize);
+        return;
     }
+    if (batchSize == 0) return;
+    optimizer.update(index, weights, biases, grads.grad_weights_sum, grads.grad_biases_sum,
+                     Scalar(1) / batchSize, learningRate);
 }
 
-void Layer::save(std::ofstream& file) const {
-    file << inputSize << " " << outputSize << " " << (int)activationType << "\n";
-    for(const auto& row : weights) {
-        for(double w : row) file << w << " ";
-        file << "\n";
+void Layer::clearGradients() {
+    gradients.clear();
+}
+
+void LayerGradients::clear() {
+    std::fill(grad_biases_sum.begin(), grad_biases_sum.end(), 0.0);
+    grad_weights_sum.fill(0.0);
+}
+
+void LayerGradients::add(const LayerGradients& other, int part, int parts) {
+    const auto& k = kernels::active<Scalar>();
+    const int rows = grad_weights_sum.rows();
+    for (int r = part * rows / parts; r < (part + 1) * rows / parts; ++r) {
+        k.axpy(1.0, other.grad_weights_sum.row(r).data(), grad_weights_sum.row(r).data(), grad_weights_sum.cols());
+    }
+    // Les lignes des poids sont les entrées d'une couche creuse : biais découpés à part
+    const int outputs = static_cast<int>(grad_biases_sum.size());
+    for (int i = part * outputs / parts; i < (part + 1) * outputs / parts; ++i) {
+        grad_biases_sum[i] += other.grad_biases_sum[i];
     }
-    for(double b : biases) file << b << " ";
-    file << "\n";
 }
 
 void Layer::loadWeights(std::ifstream& file) {
     for(int i=0; i<outputSize; ++i) {
         for(int j=0; j<inputSize; ++j) {
-            file >> weights[i][j];
+            file >> at(i, j);
         }
     }
     for(int i=0; i<outputSize; ++i) {
@@ -31,7 +31,7 @@ namespace nn::loss {
 
         for(size_t i = 0; i < predicted.size(); ++i) {
             // Clamp pour stabilité numérique
-            double val = std::max(epsilon, std::min(1.0 - epsilon, predicted[i]));
+            double val = std::max(epsilon, std::min(1.0 - epsilon, static_cast<double>(predicted[i])));
             // Pour classification multi-classes : -Σ(y_i × log(p_i))
             sum -= expected[i] * std::log(val);
         }
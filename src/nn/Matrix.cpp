@@ -0,0 +1,58 @@
+#include "Matrix.hpp"
+#include <algorithm>
+
+namespace nn {
+
+Matrix::Matrix(int rows, int cols, Scalar value) {
+    resize(rows, cols, value);
+}
+
+Matrix::Matrix(const Matrix& other)
+    : numRows(other.numRows), numCols(other.numCols), rowStride(other.rowStride) {
+    storage.assign(other.data(), other.data() + (std::size_t)numRows * rowStride);
+}
+
+Matrix& Matrix::operator=(const Matrix& other) {
+    if (this != &other) {
+        numRows = other.numRows;
+        numCols = other.numCols;
+        rowStride = other.rowStride;
+        external = nullptr;
+        storage.assign(other.data(), other.data() + (std::size_t)numRows * rowStride);
+    }
+    return *this;
+}
+
+int Matrix::strideFor(int cols) {
+    constexpr int perLine = ALIGNMENT / sizeof(Scalar);
+    // Arrondir le stride au multiple de la ligne de cache
+    return (cols + perLine - 1) / perLine * perLine;
+}
+
+Matrix Matrix::view(Scalar* data, int rows, int cols) {
+    Matrix m;
+    m.numRows = rows;
+    m.numCols = cols;
+    m.rowStride = strideFor(cols);
+    m.external = data;
+    return m;
+}
+
+void Matrix::resize(int rows, int cols, Scalar value) {
+    numRows = rows;
+    numCols = cols;
+    rowStride = strideFor(cols);
+    external = nullptr;
+    storage.assign((std::size_t)rows * rowStride, Scalar(0));
+    if (value != Scalar(0)) fill(value);
+}
+
+void Matrix::fill(Scalar value) {
+    // Le padding reste à zéro pour que les kernels puissent le lire sans effet
+    for (int i = 0; i < numRows; ++i) {
+        auto r = row(i);
+        std::fill(r.begin(), r.end(), value);
+    }
+}
+
+} // namespace nn
@@ -0,0 +1,186 @@
+#include "ModelFile.hpp"
+#include "Network.hpp"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nn::model {
+
+namespace {
+
+std::uint64_t fnv1a(const unsigned char* data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+}
+
+constexpr std::size_t LAYER_RECORD_V1_SIZE = 32;   // Sans transposed ni reserved
+
+// Lignes et colonnes du bloc de poids tel que stocké
+int storedRows(const LayerRecord& r) { return r.transposed ? r.inputSize : r.outputSize; }
+int storedCols(const LayerRecord& r) { return r.transposed ? r.outputSize : r.inputSize; }
+
+// Copie un bloc du fichier (scalaire From) vers un stockage propre (Scalar)
+template <typename From>
+Matrix convertWeights(const unsigned char* base, const LayerRecord& r) {
+    Matrix m(storedRows(r), storedCols(r));
+    for (int i = 0; i < m.rows(); ++i) {
+        const From* src = reinterpret_cast<const From*>(base + r.weightsOffset) + (std::size_t)i * r.stride;
+        for (int j = 0; j < m.cols(); ++j) m(i, j) = static_cast<Scalar>(src[j]);
+    }
+    return m;
+}
+
+template <typename From>
+std::vector<Scalar> convertBiases(const unsigned char* base, const LayerRecord& r) {
+    const From* src = reinterpret_cast<const From*>(base + r.biasesOffset);
+    return std::vector<Scalar>(src, src + r.outputSize);
+}
+
+} // namespace
+
+bool isBinary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+void write(const Network& net, const std::string& path) {
+    const std::size_t count = net.layerCount();
+    std::vector<LayerRecord> records(count);
+
+    // Placement des blocs
+    std::uint64_t offset = alignUp(sizeof(Header) + count * sizeof(LayerRecord));
+    for (std::size_t l = 0; l < count; ++l) {
+        const Layer& layer = net.layer(l);
+        LayerRecord& r = records[l];
+        r = {};
+        r.inputSize = layer.getInputSize();
+        r.outputSize = layer.getOutputSize();
+        r.activation = static_cast<std::int32_t>(layer.getActivationType());
+        r.transposed = layer.hasSparseInput();
+        r.stride = Matrix::strideFor(storedCols(r));
+        r.weightsOffset = offset;
+        offset = alignUp(offset + (std::uint64_t)storedRows(r) * r.stride * sizeof(Scalar));
+        r.biasesOffset = offset;
+        offset = alignUp(offset + (std::uint64_t)r.outputSize * sizeof(Scalar));
+    }
+
+    std::vector<unsigned char> buffer(offset, 0);
+    std::memcpy(buffer.data() + sizeof(Header), records.data(), count * sizeof(LayerRecord));
+    for (std::size_t l = 0; l < count; ++l) {
+        const Layer& layer = net.layer(l);
+        const LayerRecord& r = records[l];
+        const Matrix& w = layer.getWeights();
+        for (int i = 0; i < w.rows(); ++i) {
+            std::memcpy(buffer.data() + r.weightsOffset + (std::size_t)i * r.stride * sizeof(Scalar),
+                        w.row(i).data(), w.cols() * sizeof(Scalar));
+        }
+        std::memcpy(buffer.data() + r.biasesOffset, layer.getBiases().data(), r.outputSize * sizeof(Scalar));
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.scalarSize = sizeof(Scalar);
+    header.layerCount = static_cast<std::uint32_t>(count);
+    header.fileSize = offset;
+    header.checksum = fnv1a(buffer.data() + sizeof(Header), buffer.size() - sizeof(Header));
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size())) {
+        throw std::runtime_error("Cannot write model file " + path);
+    }
+}
+
+void read(const std::string& path, Network& net) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open model file " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Model file too small: " + path);
+    }
+    const std::size_t size = st.st_size;
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("Cannot map model file " + path);
+    std::shared_ptr<void> mapping(addr, [size](void* p) { ::munmap(p, size); });
+    unsigned char* base = static_cast<unsigned char*>(addr);
+
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("Not a binary model: " + path);
+    if (header.version != VERSION && header.version != 1) {
+        throw std::runtime_error("Unsupported model version " + std::to_string(header.version));
+    }
+    const std::size_t recordSize = header.version == 1 ? LAYER_RECORD_V1_SIZE : sizeof(LayerRecord);
+    if (header.scalarSize != sizeof(float) && header.scalarSize != sizeof(double)) {
+        throw std::runtime_error("Invalid scalar size in " + path);
+    }
+    if (header.fileSize != size || sizeof(Header) + (std::uint64_t)header.layerCount * recordSize > size) {
+        throw std::runtime_error("Truncated model file " + path);
+    }
+    if (fnv1a(base + sizeof(Header), size - sizeof(Header)) != header.checksum) {
+        throw std::runtime_error("Checksum mismatch in " + path);
+    }
+
+    std::vector<LayerRecord> records(header.layerCount, LayerRecord{});
+    for (std::size_t l = 0; l < records.size(); ++l) {
+        std::memcpy(&records[l], base + sizeof(Header) + l * recordSize, recordSize);
+    }
+    // Bornes écrites sans débordement : un offset forgé ne peut pas revenir dans le fichier
+    auto outside = [size](std::uint64_t offset, std::uint64_t length) { return offset > size || length > size - offset; };
+    for (const LayerRecord& r : records) {
+        const std::uint64_t weightsCount = (std::uint64_t)storedRows(r) * (std::uint64_t)r.stride;
+        if (r.inputSize <= 0 || r.outputSize <= 0 || (r.transposed != 0 && r.transposed != 1) ||
+            r.stride < storedCols(r) || r.weightsOffset % BLOCK_ALIGNMENT != 0 ||
+            r.biasesOffset % BLOCK_ALIGNMENT != 0 || weightsCount > size / header.scalarSize ||
+            outside(r.weightsOffset, weightsCount * header.scalarSize) ||
+            outside(r.biasesOffset, (std::uint64_t)r.outputSize * header.scalarSize) ||
+            r.activation < 0 || r.activation > static_cast<int>(ActivationType::SOFTMAX)) {
+            throw std::runtime_error("Corrupted layer table in " + path);
+        }
+    }
+    for (std::size_t l = 1; l < records.size(); ++l) {
+        if (records[l].inputSize != records[l - 1].outputSize) {
+            throw std::runtime_error("Layer " + std::to_string(l + 1) + " of " + path + " expects " +
+                                     std::to_string(records[l].inputSize) + " inputs, previous layer has " +
+                                     std::to_string(records[l - 1].outputSize) + " outputs");
+        }
+    }
+
+    // Même type scalaire et même padding : vues directes sur le fichier mappé
+    const bool zeroCopy = header.scalarSize == sizeof(Scalar);
+    Network loaded;
+    for (const LayerRecord& r : records) {
+        const auto type = static_cast<ActivationType>(r.activation);
+        const bool transposed = r.transposed != 0;
+        if (zeroCopy && r.stride == Matrix::strideFor(storedCols(r))) {
+            Matrix w = Matrix::view(reinterpret_cast<Scalar*>(base + r.weightsOffset), storedRows(r), storedCols(r));
+            loaded.addLayer(Layer(std::move(w), convertBiases<Scalar>(base, r), type, transposed));
+        } else if (header.scalarSize == sizeof(float)) {
+            loaded.addLayer(Layer(convertWeights<float>(base, r), convertBiases<float>(base, r), type, transposed));
+        } else {
+            loaded.addLayer(Layer(convertWeights<double>(base, r), convertBiases<double>(base, r), type, transposed));
+        }
+    }
+    if (zeroCopy) loaded.setStorage(std::move(mapping));
+    net = std::move(loaded);
+}
+
+} // namespace nn::model
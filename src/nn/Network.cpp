@@ -1,45 +1,194 @@
 #include "Network.hpp"
+#include "ModelFile.hpp"
+#include "Optimizer.hpp"
+#include "Profiler.hpp"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 
 namespace nn {
 
 Network::Network() {}
 
+// La première couche reçoit les entrées creuses : poids rangés [input][output]
 void Network::addLayer(int inputSize, int outputSize, ActivationType type) {
-    layers.emplace_back(inputSize, outputSize, type);
+    layers.emplace_back(inputSize, outputSize, type, layers.empty());
+    workspace.offsets.clear();
 }
 
-std::vector<double> Network::forward(const std::vector<double>& input) {
-    std::vector<double> current = input;
-    for (auto& layer : layers) {
-        current = layer.forward(current);
+void Network::addLayer(Layer layer) {
+    if (layers.empty()) layer.enableSparseInput();
+    layers.push_back(std::move(layer));
+    workspace.offsets.clear();
+}
+
+std::vector<Scalar> Network::forward(const std::vector<Scalar>& input) {
+    if (layers.empty()) return input;
+    std::vector<Scalar> current = layers.front().forward(input);
+    for (size_t i = 1; i < layers.size(); ++i) {
+        current = layers[i].forward(current);
     }
     return current;
 }
 
-void Network::backward(const std::vector<double>& outputGradient, double learningRate) {
-    std::vector<double> currentGradient = outputGradient;
+InferenceWorkspace Network::makeWorkspace() const {
+    InferenceWorkspace ws;
+    std::size_t size = 0;
+    for (const auto& layer : layers) {
+        ws.offsets.push_back(size);
+        size += Matrix::strideFor(layer.getOutputSize()); // Chaque tranche commence sur une ligne de cache
+    }
+    ws.offsets.push_back(size);
+    ws.arena.assign(size, Scalar(0));
+    return ws;
+}
+
+std::span<const Scalar> Network::infer(std::span<const Scalar> input, InferenceWorkspace& ws) const {
+    if (layers.empty()) return input;
+    if (input.size() != static_cast<std::size_t>(layers.front().getInputSize())) {
+        throw std::invalid_argument("Input size " + std::to_string(input.size()) + " does not match the network input " +
+                                    std::to_string(layers.front().getInputSize()));
+    }
+    const Scalar* current = input.data();
+    for (size_t i = 0; i < layers.size(); ++i) {
+        Scalar* out = ws.arena.data() + ws.offsets[i];
+        layers[i].infer(current, out);
+        current = out;
+    }
+    return {current, static_cast<std::size_t>(layers.back().getOutputSize())};
+}
+
+std::span<const Scalar> Network::infer(std::span<const int> active, InferenceWorkspace& ws) const {
+    if (layers.empty()) return {};
+    Scalar* current = ws.arena.data();
+    layers.front().infer(active, current);
+    for (size_t i = 1; i < layers.size(); ++i) {
+        Scalar* out = ws.arena.data() + ws.offsets[i];
+        layers[i].infer(current, out);
+        current = out;
+    }
+    return {current, static_cast<std::size_t>(layers.back().getOutputSize())};
+}
+
+InferenceWorkspace& Network::ownWorkspace() {
+    if (workspace.offsets.size() != layers.size() + 1) workspace = makeWorkspace();
+    return workspace;
+}
+
+std::span<const Scalar> Network::infer(std::span<const Scalar> input) {
+    return infer(input, ownWorkspace());
+}
+
+std::span<const Scalar> Network::infer(std::span<const int> active) {
+    return infer(active, ownWorkspace());
+}
+
+void Network::backward(const std::vector<Scalar>& outputGradient, double learningRate) {
+    std::vector<Scalar> currentGradient = outputGradient;
 
     for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
         currentGradient = it->backward(currentGradient, learningRate);
     }
 }
 
-void Network::backward(const std::vector<double>& outputGradient) {
-    std::vector<double> currentGradient = outputGradient;
+void Network::backward(const std::vector<Scalar>& outputGradient) {
+    std::vector<Scalar> currentGradient = outputGradient;
     for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
         currentGradient = it->backward(currentGradient);
     }
 }
 
-void Network::accumulateGradients(const std::vector<double>& outputGradient) {
-    std::vector<double> currentGradient = outputGradient;
+void Network::accumulateGradients(const std::vector<Scalar>& outputGradient) {
+    // Un seul passage fusionné par couche ; la première ne calcule pas grad_input
+    const Scalar* currentGradient = outputGradient.data();
+    for (size_t i = layers.size(); i-- > 0;) {
+        std::vector<Scalar>& next = backwardBuffers[i % 2];
+        if (i > 0) next.resize(layers[i].getInputSize());
+        layers[i].backwardFused(currentGradient, i > 0 ? next.data() : nullptr);
+        currentGradient = next.data();
+    }
+}
 
-    for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
-        it->accumulateGradients(currentGradient);
-        currentGradient = it->backward(currentGradient); // Get grad_input for next layer
+Matrix Network::forwardBatch(const Matrix& input) {
+    if (layers.empty()) return input;
+    Matrix current = layers.front().forwardBatch(input);
+    for (size_t i = 1; i < layers.size(); ++i) {
+        current = layers[i].forwardBatch(current);
+    }
+    return current;
+}
+
+Matrix Network::forwardBatch(const SparseBatch& input) {
+    if (layers.empty()) return input.toDense();
+    Matrix current = layers.front().forwardBatch(input);
+    for (size_t i = 1; i < layers.size(); ++i) {
+        current = layers[i].forwardBatch(current);
+    }
+    return current;
+}
+
+void Network::backwardBatch(const Matrix& outputGradient) {
+    Matrix currentGradient = outputGradient;
+    for (size_t i = layers.size(); i-- > 0;) {
+        currentGradient = layers[i].backwardBatch(currentGradient, i > 0);
+    }
+}
+
+WorkerState Network::makeWorkerState() const {
+    WorkerState state;
+    state.caches.resize(layers.size());
+    for (const auto& layer : layers) {
+        state.grads.push_back(layer.makeGradients());
+    }
+    return state;
+}
+
+const Matrix& Network::forwardBatch(const Matrix& input, WorkerState& state) const {
+    if (layers.empty()) return input;
+    const Matrix* current = &input;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        MYTORCH_PROFILE_SCOPE(profile::FORWARD, i);
+        current = &layers[i].forwardBatch(*current, state.caches[i]);
+    }
+    return *current;
+}
+
+const Matrix& Network::forwardBatch(const SparseBatch& input, WorkerState& state) const {
+    const Matrix* current;
+    {
+        MYTORCH_PROFILE_SCOPE(profile::FORWARD, 0);
+        current = &layers.front().forwardBatch(input, state.caches.front());
+    }
+    for (size_t i = 1; i < layers.size(); ++i) {
+        MYTORCH_PROFILE_SCOPE(profile::FORWARD, i);
+        current = &layers[i].forwardBatch(*current, state.caches[i]);
+    }
+    return *current;
+}
+
+void Network::backwardBatch(const Matrix& outputGradient, WorkerState& state) const {
+    const Matrix* currentGradient = &outputGradient;
+    for (size_t i = layers.size(); i-- > 0;) {
+        MYTORCH_PROFILE_SCOPE(profile::BACKWARD, i);
+        currentGradient = &layers[i].backwardBatch(*currentGradient, state.caches[i], state.grads[i], i > 0);
+    }
+}
+
+void Network::applyGradients(const std::vector<LayerGradients>& grads, double learningRate, int batchSize) {
+    for (size_t i = 0; i < layers.size(); ++i) {
+        MYTORCH_PROFILE_SCOPE(profile::UPDATE, i);
+        layers[i].applyGradients(grads[i], learningRate, batchSize);
+    }
+}
+
+void Network::applyGradients(const std::vector<LayerGradients>& grads, double learningRate, int batchSize,
+                             Optimizer& optimizer) {
+    optimizer.beginStep();
+    for (size_t i = 0; i < layers.size(); ++i) {
+        MYTORCH_PROFILE_SCOPE(profile::UPDATE, i);
+        layers[i].applyGradients(grads[i], learningRate, batchSize, optimizer, i);
     }
 }
 
@@ -50,22 +199,28 @@ void Network::updateWeights(double learningRate, int batchSize) {
 }
 
 void Network::save(const std::string& path) const {
-    std::ofstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot save model to " << path << std::endl;
+    try {
+        model::write(*this, path);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Cannot save model to " << path << " (" << e.what() << ")" << std::endl;
         return;
     }
-
-    file << layers.size() << "\n";
-
-    for (const auto& layer : layers) {
-        layer.save(file);
-    }
-
-    std::cout << "Model saved to " << path << std::endl;
+    std::cerr << "Model saved to " << path << std::endl;
 }
 
 void Network::load(const std::string& path) {
+    if (model::isBinary(path)) {
+        try {
+            model::read(path, *this);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Cannot load model " << path << " (" << e.what() << ")" << std::endl;
+            return;
+        }
+        std::cerr << "Model loaded from " << path << std::endl;
+        return;
+    }
+
+    // Ancien format texte : "n_layers" puis "in out activation", poids ligne par ligne, biais
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot load model " << path << std::endl;
@@ -73,6 +228,8 @@ void Network::load(const std::string& path) {
     }
 
     layers.clear();
+    storage.reset();
+    workspace.offsets.clear();
     size_t numLayers;
     file >> numLayers;
 
@@ -84,6 +241,6 @@ void Network::load(const std::string& path) {
 
         layers.back().loadWeights(file);
     }
-    std::cout << "Model loaded from " << path << std::endl;
+    std::cerr << "Model loaded from " << path << std::endl;
 }
-} // namespace nn
\ No newline at end of file
+} // namespace nn
@@ -0,0 +1,241 @@
+#include "Optimizer.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace nn {
+
+namespace {
+
+constexpr char MAGIC[4] = {'M', 'T', 'O', 'P'};
+constexpr std::uint32_t VERSION = 2;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t type;            // OptimizerType
+    std::uint32_t scalarSize;
+    std::uint32_t layerCount;
+    std::uint32_t stateCount;
+    std::uint64_t step;
+};
+
+// w -= lr * (scale * g + wd * w)
+class Sgd : public Optimizer {
+public:
+    explicit Sgd(const OptimizerOptions& options) : Optimizer(options, 0) {}
+
+protected:
+    void updateLayer(Slot&, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                     std::span<const Scalar> gradBiases, Scalar scale, double learningRate) override {
+        const Scalar step = static_cast<Scalar>(learningRate) * scale;
+        const Scalar keep = static_cast<Scalar>(1.0 - learningRate * opts.weightDecay);
+        for (int i = 0; i < weights.rows(); ++i) {
+            Scalar* w = weights.row(i).data();
+            const Scalar* g = grad.row(i).data();
+            for (int j = 0; j < weights.cols(); ++j) w[j] = keep * w[j] - step * g[j];
+        }
+        for (size_t i = 0; i < biases.size(); ++i) biases[i] -= step * gradBiases[i];
+    }
+};
+
+// g = scale * g + wd * w ; v = mu * v + g ; w -= lr * v (Nesterov : w -= lr * (g + mu * v))
+class Momentum : public Optimizer {
+public:
+    Momentum(const OptimizerOptions& options, bool nesterov) : Optimizer(options, 1), nesterov(nesterov) {}
+
+protected:
+    void updateLayer(Slot& slot, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                     std::span<const Scalar> gradBiases, Scalar scale, double learningRate) override {
+        const Scalar mu = static_cast<Scalar>(opts.momentum);
+        const Scalar lr = static_cast<Scalar>(learningRate);
+        const Scalar l2 = static_cast<Scalar>(opts.weightDecay);
+        auto apply = [&](Scalar* w, Scalar* v, const Scalar* g, int n, Scalar decay) {
+            if (nesterov) {
+                for (int j = 0; j < n; ++j) {
+                    const Scalar gj = g[j] * scale + decay * w[j];
+                    v[j] = mu * v[j] + gj;
+                    w[j] -= lr * (gj + mu * v[j]);
+                }
+            } else {
+                for (int j = 0; j < n; ++j) {
+                    v[j] = mu * v[j] + g[j] * scale + decay * w[j];
+                    w[j] -= lr * v[j];
+                }
+            }
+        };
+        for (int i = 0; i < weights.rows(); ++i) {
+            apply(weights.row(i).data(), slot.weights[0].row(i).data(), grad.row(i).data(), weights.cols(), l2);
+        }
+        apply(biases.data(), slot.biases[0].data(), gradBiases.data(), static_cast<int>(biases.size()), 0);
+    }
+
+private:
+    bool nesterov;
+};
+
+// m = b1 m + (1 - b1) g ; v = b2 v + (1 - b2) g² ; w -= lr * m^ / (sqrt(v^) + eps).
+// Adam ajoute la décroissance au gradient (L2), AdamW l'applique directement aux poids.
+class Adam : public Optimizer {
+public:
+    Adam(const OptimizerOptions& options, bool decoupled) : Optimizer(options, 2), decoupled(decoupled) {}
+
+protected:
+    void updateLayer(Slot& slot, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                     std::span<const Scalar> gradBiases, Scalar scale, double learningRate) override {
+        const Scalar b1 = static_cast<Scalar>(opts.beta1);
+        const Scalar b2 = static_cast<Scalar>(opts.beta2);
+        // Corrections de biais repliées dans le pas : lr * sqrt(1 - b2^t) / (1 - b1^t)
+        const double t = static_cast<double>(step);
+        const Scalar stepSize = static_cast<Scalar>(learningRate * std::sqrt(1.0 - std::pow(opts.beta2, t)) /
+                                                    (1.0 - std::pow(opts.beta1, t)));
+        const Scalar epsHat = static_cast<Scalar>(opts.epsilon * std::sqrt(1.0 - std::pow(opts.beta2, t)));
+        const Scalar l2 = decoupled ? 0 : static_cast<Scalar>(opts.weightDecay);
+        const Scalar shrink = decoupled ? static_cast<Scalar>(1.0 - learningRate * opts.weightDecay) : 1;
+
+        auto apply = [&](Scalar* w, Scalar* m, Scalar* v, const Scalar* g, int n, Scalar decay, Scalar keep) {
+            for (int j = 0; j < n; ++j) {
+                const Scalar gj = g[j] * scale + decay * w[j];
+                m[j] = b1 * m[j] + (1 - b1) * gj;
+                v[j] = b2 * v[j] + (1 - b2) * gj * gj;
+                w[j] = keep * w[j] - stepSize * m[j] / (std::sqrt(v[j]) + epsHat);
+            }
+        };
+        for (int i = 0; i < weights.rows(); ++i) {
+            apply(weights.row(i).data(), slot.weights[0].row(i).data(), slot.weights[1].row(i).data(),
+                  grad.row(i).data(), weights.cols(), l2, shrink);
+        }
+        apply(biases.data(), slot.biases[0].data(), slot.biases[1].data(), gradBiases.data(),
+              static_cast<int>(biases.size()), 0, 1);
+    }
+
+private:
+    bool decoupled;
+};
+
+} // namespace
+
+OptimizerType Optimizer::parseType(const std::string& name) {
+    if (name == "sgd") return OptimizerType::SGD;
+    if (name == "momentum") return OptimizerType::MOMENTUM;
+    if (name == "nesterov") return OptimizerType::NESTEROV;
+    if (name == "adam") return OptimizerType::ADAM;
+    if (name == "adamw") return OptimizerType::ADAMW;
+    throw std::runtime_error("Unknown optimizer: " + name);
+}
+
+const char* Optimizer::typeName(OptimizerType type) {
+    switch (type) {
+        case OptimizerType::SGD: return "sgd";
+        case OptimizerType::MOMENTUM: return "momentum";
+        case OptimizerType::NESTEROV: return "nesterov";
+        case OptimizerType::ADAM: return "adam";
+        case OptimizerType::ADAMW: return "adamw";
+    }
+    return "unknown";
+}
+
+std::unique_ptr<Optimizer> Optimizer::create(const OptimizerOptions& options) {
+    switch (options.type) {
+        case OptimizerType::MOMENTUM: return std::make_unique<Momentum>(options, false);
+        case OptimizerType::NESTEROV: return std::make_unique<Momentum>(options, true);
+        case OptimizerType::ADAM: return std::make_unique<Adam>(options, false);
+        case OptimizerType::ADAMW: return std::make_unique<Adam>(options, true);
+        case OptimizerType::SGD: break;
+    }
+    return std::make_unique<Sgd>(options);
+}
+
+void Optimizer::update(std::size_t layer, Matrix& weights, std::span<Scalar> biases, const Matrix& grad,
+                       std::span<const Scalar> gradBiases, Scalar scale, double learningRate) {
+    if (slots.size() <= layer) slots.resize(layer + 1);
+    Slot& slot = slots[layer];
+    if (slot.weights.empty() && stateBuffers > 0) {
+        slot.weights.assign(stateBuffers, Matrix(weights.rows(), weights.cols()));
+        slot.biases.assign(stateBuffers, std::vector<Scalar>(biases.size(), 0));
+    }
+    for (const Matrix& m : slot.weights) {
+        if (m.rows() != weights.rows() || m.cols() != weights.cols()) {
+            throw std::runtime_error("Optimizer state does not match the network topology");
+        }
+    }
+    for (const std::vector<Scalar>& b : slot.biases) {
+        if (b.size() != biases.size()) {
+            throw std::runtime_error("Optimizer state does not match the network topology");
+        }
+    }
+    updateLayer(slot, weights, biases, grad, gradBiases, scale, learningRate);
+}
+
+void Optimizer::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("Cannot open " + path);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.type = static_cast<std::uint32_t>(opts.type);
+    header.scalarSize = sizeof(Scalar);
+    header.layerCount = static_cast<std::uint32_t>(slots.size());
+    header.stateCount = static_cast<std::uint32_t>(stateBuffers);
+    header.step = step;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Par couche : lignes, colonnes, nombre de biais, puis chaque buffer de poids (sans padding) et
+    // de biais. Le nombre de biais est à part : la couche creuse range ses poids en [input][output].
+    for (const Slot& slot : slots) {
+        const std::int32_t shape[3] = {slot.weights.empty() ? 0 : slot.weights[0].rows(),
+                                       slot.weights.empty() ? 0 : slot.weights[0].cols(),
+                                       slot.biases.empty() ? 0 : static_cast<std::int32_t>(slot.biases[0].size())};
+        file.write(reinterpret_cast<const char*>(shape), sizeof(shape));
+        for (int s = 0; s < static_cast<int>(slot.weights.size()); ++s) {
+            for (int i = 0; i < shape[0]; ++i) {
+                file.write(reinterpret_cast<const char*>(slot.weights[s].row(i).data()), shape[1] * sizeof(Scalar));
+            }
+            file.write(reinterpret_cast<const char*>(slot.biases[s].data()), shape[2] * sizeof(Scalar));
+        }
+    }
+    if (!file) throw std::runtime_error("Cannot write " + path);
+}
+
+void Optimizer::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open " + path);
+
+    Header header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        throw std::runtime_error(path + " is not an optimizer state file");
+    }
+    if (header.type != static_cast<std::uint32_t>(opts.type)) {
+        throw std::runtime_error(path + " holds " + typeName(static_cast<OptimizerType>(header.type)) +
+                                 " state, not " + typeName(opts.type));
+    }
+    if (header.scalarSize != sizeof(Scalar) || header.stateCount != static_cast<std::uint32_t>(stateBuffers)) {
+        throw std::runtime_error(path + " was written by an incompatible build");
+    }
+
+    std::vector<Slot> loaded(header.layerCount);
+    for (Slot& slot : loaded) {
+        std::int32_t shape[3];
+        if (!file.read(reinterpret_cast<char*>(shape), sizeof(shape)) || shape[0] < 0 || shape[1] < 0 ||
+            shape[2] < 0) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        if (shape[0] == 0) continue;
+        slot.weights.assign(stateBuffers, Matrix(shape[0], shape[1]));
+        slot.biases.assign(stateBuffers, std::vector<Scalar>(shape[2]));
+        for (int s = 0; s < stateBuffers; ++s) {
+            for (int i = 0; i < shape[0]; ++i) {
+                file.read(reinterpret_cast<char*>(slot.weights[s].row(i).data()), shape[1] * sizeof(Scalar));
+            }
+            file.read(reinterpret_cast<char*>(slot.biases[s].data()), shape[2] * sizeof(Scalar));
+        }
+        if (!file) throw std::runtime_error(path + " is truncated");
+    }
+    slots = std::move(loaded);
+    step = header.step;
+}
+
+} // namespace nn
@@ -0,0 +1,117 @@
+#include "ParallelTrainer.hpp"
+#include "Loss.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+namespace nn {
+
+namespace {
+
+int argmax(std::span<const Scalar> values) {
+    int best = 0;
+    for (size_t k = 1; k < values.size(); ++k) {
+        if (values[k] > values[best]) best = static_cast<int>(k);
+    }
+    return best;
+}
+
+void copyRows(const Matrix& src, int begin, int end, Matrix& dst) {
+    dst.resize(end - begin, src.cols());
+    for (int r = begin; r < end; ++r) {
+        std::copy(src.row(r).begin(), src.row(r).end(), dst.row(r - begin).begin());
+    }
+}
+
+void copyRows(const SparseBatch& src, int begin, int end, SparseBatch& dst) {
+    dst.clear(src.cols());
+    for (int r = begin; r < end; ++r) dst.addRow(src.row(r));
+}
+
+} // namespace
+
+ParallelTrainer::ParallelTrainer(Network& net, int threads, Optimizer* optimizer)
+    : net(net), optimizer(optimizer), pool(std::max(1, threads)) {
+    shards.resize(pool.size());
+    for (auto& shard : shards) {
+        shard.state = net.makeWorkerState();
+    }
+}
+
+ParallelTrainer::BatchStats ParallelTrainer::trainBatch(const Matrix& inputs, const Matrix& targets, double learningRate) {
+    const int rows = inputs.rows();
+    const int count = static_cast<int>(shards.size());
+
+    // Découpage déterministe : la tranche s couvre [s*rows/count, (s+1)*rows/count)
+    for (int s = 0; s < count; ++s) {
+        copyRows(inputs, s * rows / count, (s + 1) * rows / count, shards[s].inputs);
+        copyRows(targets, s * rows / count, (s + 1) * rows / count, shards[s].targets);
+        shards[s].sparse = false;
+    }
+    return runShards(rows, learningRate);
+}
+
+ParallelTrainer::BatchStats ParallelTrainer::trainBatch(const SparseBatch& inputs, const Matrix& targets, double learningRate) {
+    const int rows = inputs.rows();
+    const int count = static_cast<int>(shards.size());
+
+    for (int s = 0; s < count; ++s) {
+        copyRows(inputs, s * rows / count, (s + 1) * rows / count, shards[s].sparseInputs);
+        copyRows(targets, s * rows / count, (s + 1) * rows / count, shards[s].targets);
+        shards[s].sparse = true;
+    }
+    return runShards(rows, learningRate);
+}
+
+ParallelTrainer::BatchStats ParallelTrainer::runShards(int rows, double learningRate) {
+    const int count = static_cast<int>(shards.size());
+    pool.parallelFor(count, [this](int s) { runShard(shards[s]); });
+    reduceGradients();
+    if (optimizer) net.applyGradients(shards[0].state.grads, learningRate, rows, *optimizer);
+    else net.applyGradients(shards[0].state.grads, learningRate, rows);
+
+    BatchStats total;
+    for (const auto& shard : shards) {
+        total.loss += shard.stats.loss;
+        total.correct += shard.stats.correct;
+    }
+    return total;
+}
+
+void ParallelTrainer::runShard(Shard& shard) {
+    MYTORCH_TRACE_SCOPE("shard");
+    shard.stats = BatchStats();
+    for (auto& g : shard.state.grads) g.clear();
+    if (shard.targets.rows() == 0) return;
+
+    const Matrix& output = shard.sparse ? net.forwardBatch(shard.sparseInputs, shard.state)
+                                        : net.forwardBatch(shard.inputs, shard.state);
+    shard.grad.resize(output.rows(), output.cols());
+    for (int b = 0; b < output.rows(); ++b) {
+        loss::Vector out(output.row(b).begin(), output.row(b).end());
+        loss::Vector expected(shard.targets.row(b).begin(), shard.targets.row(b).end());
+        shard.stats.loss += loss::crossEntropy(out, expected);
+        if (argmax(output.row(b)) == argmax(shard.targets.row(b))) shard.stats.correct++;
+
+        auto g = loss::crossEntropyDerivative(out, expected);
+        std::copy(g.begin(), g.end(), shard.grad.row(b).begin());
+    }
+    net.backwardBatch(shard.grad, shard.state);
+}
+
+void ParallelTrainer::reduceGradients() {
+    const int count = static_cast<int>(shards.size());
+    if (count == 1) return;
+
+    auto& total = shards[0].state.grads;
+    for (size_t l = 0; l < total.size(); ++l) {
+        MYTORCH_PROFILE_SCOPE(profile::UPDATE, l);   // La réduction compte dans la mise à jour
+        // Chaque tâche réduit une tranche de lignes, toujours dans l'ordre des tranches
+        pool.parallelFor(count, [&, l](int t) {
+            for (int s = 1; s < count; ++s) {
+                total[l].add(shards[s].state.grads[l], t, count);
+            }
+        });
+    }
+}
+
+} // namespace nn
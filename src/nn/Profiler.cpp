@@ -0,0 +1,27 @@
+#include "Profiler.hpp"
+#include <sys/resource.h>
+
+namespace nn::profile {
+
+void setEnabled(bool on) {
+    active.store(on, std::memory_order_relaxed);
+}
+
+void reset() {
+    for (auto& phase : totals) {
+        for (auto& total : phase) total.store(0, std::memory_order_relaxed);
+    }
+}
+
+double seconds(Phase phase, std::size_t layer) {
+    if (layer >= MAX_LAYERS) return 0.0;
+    return static_cast<double>(totals[phase][layer].load(std::memory_order_relaxed)) * 1e-9;
+}
+
+std::size_t peakRssBytes() {
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // Linux : en kilo-octets
+}
+
+} // namespace nn::profile
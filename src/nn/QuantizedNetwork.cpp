@@ -0,0 +1,256 @@
+#include "QuantizedNetwork.hpp"
+#include "Activations.hpp"
+#include "Kernels.hpp"
+#include "Network.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace nn {
+
+namespace {
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t layerCount;
+    std::uint32_t granularity;
+};
+
+struct LayerRecord {
+    std::int32_t inputSize;
+    std::int32_t outputSize;
+    std::int32_t activation;
+    std::int32_t stride;
+    float outputScale;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 16 && sizeof(LayerRecord) == 24, "quantized model layout must not change");
+
+int paddedStride(int n) {
+    return (n + 63) / 64 * 64;
+}
+
+void activate(ActivationType type, Scalar* z, int n) {
+    const auto& k = kernels::active<Scalar>();
+    withActivation(type, [&](auto act) { act.apply(k, z, z, n); });
+}
+
+} // namespace
+
+QuantizedNetwork QuantizedNetwork::quantize(const Network& net, const SparseBatch& calibration, Granularity granularity) {
+    const std::size_t count = net.layerCount();
+    if (count == 0) throw std::invalid_argument("Cannot quantize an empty network");
+
+    // Plus grande sortie de chaque couche sur la calibration (les activations sont toutes >= 0)
+    int widest = 0;
+    for (std::size_t l = 0; l < count; ++l) widest = std::max(widest, net.layer(l).getOutputSize());
+    std::vector<Scalar> peaks(count, Scalar(0));
+    std::vector<Scalar> current(widest), next(widest);
+    for (int r = 0; r < calibration.rows(); ++r) {
+        net.layer(0).infer(calibration.row(r), current.data());
+        for (std::size_t l = 0;; ++l) {
+            const int outputs = net.layer(l).getOutputSize();
+            peaks[l] = std::max(peaks[l], *std::max_element(current.begin(), current.begin() + outputs));
+            if (l + 1 == count) break;
+            net.layer(l + 1).infer(current.data(), next.data());
+            current.swap(next);
+        }
+    }
+
+    QuantizedNetwork q;
+    q.mode = granularity;
+    q.layers.resize(count);
+    float inputScale = 1.0f;   // Entrée binaire : un pas vaut 1
+    for (std::size_t l = 0; l < count; ++l) {
+        const Layer& source = net.layer(l);
+        QLayer& layer = q.layers[l];
+        const bool first = l == 0;
+        layer.inputSize = source.getInputSize();
+        layer.outputSize = source.getOutputSize();
+        layer.activation = source.getActivationType();
+        layer.stride = paddedStride(first ? layer.outputSize : layer.inputSize);
+        if (l + 1 < count && peaks[l] > 0) layer.outputScale = static_cast<float>(peaks[l] / ACTIVATION_MAX);
+
+        std::vector<Scalar> weightScales(layer.outputSize);
+        Scalar layerPeak = 0;
+        for (int i = 0; i < layer.outputSize; ++i) {
+            Scalar rowPeak = 0;
+            for (int j = 0; j < layer.inputSize; ++j) rowPeak = std::max(rowPeak, std::abs(source.weight(i, j)));
+            weightScales[i] = rowPeak;
+            layerPeak = std::max(layerPeak, rowPeak);
+        }
+        for (Scalar& s : weightScales) {
+            const Scalar peak = granularity == Granularity::LAYER ? layerPeak : s;
+            s = peak > 0 ? peak / WEIGHT_MAX : Scalar(1);
+        }
+
+        layer.weights.assign(static_cast<std::size_t>(first ? layer.inputSize : layer.outputSize) * layer.stride, 0);
+        layer.scales.resize(layer.outputSize);
+        layer.biases.resize(layer.outputSize);
+        for (int i = 0; i < layer.outputSize; ++i) {
+            for (int j = 0; j < layer.inputSize; ++j) {
+                const long value = std::lround(source.weight(i, j) / weightScales[i]);
+                const auto quantized = static_cast<std::int8_t>(std::clamp<long>(value, -WEIGHT_MAX, WEIGHT_MAX));
+                layer.weights[first ? static_cast<std::size_t>(j) * layer.stride + i
+                                    : static_cast<std::size_t>(i) * layer.stride + j] = quantized;
+            }
+            // Le biais est ajouté à l'accumulateur : même unité que les produits
+            layer.scales[i] = static_cast<float>(weightScales[i] * inputScale);
+            const double bias = std::round(source.getBiases()[i] / static_cast<double>(layer.scales[i]));
+            layer.biases[i] = static_cast<std::int32_t>(std::clamp<double>(bias, std::numeric_limits<std::int32_t>::min(),
+                                                                          std::numeric_limits<std::int32_t>::max()));
+        }
+        inputScale = layer.outputScale;
+    }
+    q.allocateBuffers();
+    return q;
+}
+
+void QuantizedNetwork::allocateBuffers() {
+    int widestStride = 0, widestOutput = 0;
+    for (const QLayer& layer : layers) {
+        widestStride = std::max({widestStride, layer.stride, paddedStride(layer.outputSize)});
+        widestOutput = std::max(widestOutput, layer.outputSize);
+    }
+    accumulators.assign(widestStride, 0);
+    activations[0].assign(widestStride, 0);
+    activations[1].assign(widestStride, 0);
+    values.assign(widestOutput, Scalar(0));
+}
+
+std::span<const Scalar> QuantizedNetwork::infer(std::span<const int> active) {
+    const auto& k = kernels::activeInt8();
+    const std::uint8_t* input = nullptr;
+    int slot = 0;
+    for (std::size_t l = 0; l < layers.size(); ++l) {
+        const QLayer& layer = layers[l];
+        std::int32_t* acc = accumulators.data();
+        const int outputs = layer.outputSize;
+
+        if (l == 0) {
+            // Les colonnes paddées sont nulles : les places au-delà de outputs ne changent pas
+            std::copy(layer.biases.begin(), layer.biases.end(), acc);
+            for (int j : active) {
+                if (static_cast<unsigned>(j) >= static_cast<unsigned>(layer.inputSize)) {
+                    throw std::out_of_range("Sparse feature index " + std::to_string(j) + " out of range");
+                }
+                k.addColumn(layer.weights.data() + static_cast<std::size_t>(j) * layer.stride, acc, layer.stride);
+            }
+        } else {
+            // Les poids paddés sont nuls : les octets d'entrée au-delà de inputSize sont sans effet
+            int i = 0;
+            for (; i + 4 <= outputs; i += 4) {
+                const std::int8_t* rows[4] = {&layer.weights[static_cast<std::size_t>(i) * layer.stride],
+                                              &layer.weights[static_cast<std::size_t>(i + 1) * layer.stride],
+                                              &layer.weights[static_cast<std::size_t>(i + 2) * layer.stride],
+                                              &layer.weights[static_cast<std::size_t>(i + 3) * layer.stride]};
+                k.dot4(input, rows, layer.stride, acc + i);
+            }
+            for (; i < outputs; ++i) acc[i] = k.dot(input, &layer.weights[static_cast<std::size_t>(i) * layer.stride], layer.stride);
+            for (i = 0; i < outputs; ++i) acc[i] += layer.biases[i];
+        }
+
+        Scalar* z = values.data();
+        for (int i = 0; i < outputs; ++i) z[i] = static_cast<Scalar>(acc[i]) * layer.scales[i];
+        activate(layer.activation, z, outputs);
+        if (l + 1 == layers.size()) return {z, static_cast<std::size_t>(outputs)};
+
+        std::uint8_t* quantized = activations[slot].data();
+        const Scalar inverse = Scalar(1) / layer.outputScale;
+        for (int i = 0; i < outputs; ++i) {
+            // Sans branche : la boucle se vectorise
+            const Scalar v = std::clamp(z[i] * inverse, Scalar(0), Scalar(ACTIVATION_MAX));
+            quantized[i] = static_cast<std::uint8_t>(v + Scalar(0.5));
+        }
+        input = quantized;
+        slot ^= 1;
+    }
+    return {};
+}
+
+std::size_t QuantizedNetwork::parameterBytes() const {
+    std::size_t bytes = 0;
+    for (const QLayer& layer : layers) {
+        bytes += layer.weights.size() + layer.scales.size() * sizeof(float) + layer.biases.size() * sizeof(std::int32_t);
+    }
+    return bytes;
+}
+
+bool QuantizedNetwork::isQuantized(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void QuantizedNetwork::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("Cannot open " + path);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.layerCount = static_cast<std::uint32_t>(layers.size());
+    header.granularity = static_cast<std::uint32_t>(mode);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const QLayer& layer : layers) {
+        const LayerRecord record{layer.inputSize, layer.outputSize, static_cast<std::int32_t>(layer.activation),
+                                 layer.stride, layer.outputScale, 0};
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(layer.weights.data()), layer.weights.size());
+        file.write(reinterpret_cast<const char*>(layer.scales.data()), layer.scales.size() * sizeof(float));
+        file.write(reinterpret_cast<const char*>(layer.biases.data()), layer.biases.size() * sizeof(std::int32_t));
+    }
+    if (!file) throw std::runtime_error("Cannot write " + path);
+}
+
+void QuantizedNetwork::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open " + path);
+
+    Header header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        throw std::runtime_error(path + " is not a quantized model");
+    }
+    if (header.layerCount == 0 || header.granularity > static_cast<std::uint32_t>(Granularity::CHANNEL)) {
+        throw std::runtime_error(path + " is corrupted");
+    }
+
+    std::vector<QLayer> loaded(header.layerCount);
+    for (std::size_t l = 0; l < loaded.size(); ++l) {
+        LayerRecord record{};
+        if (!file.read(reinterpret_cast<char*>(&record), sizeof(record))) throw std::runtime_error(path + " is truncated");
+        const bool first = l == 0;
+        if (record.inputSize <= 0 || record.outputSize <= 0 || record.activation < 0 ||
+            record.activation > static_cast<std::int32_t>(ActivationType::SOFTMAX) ||
+            record.stride != paddedStride(first ? record.outputSize : record.inputSize) ||
+            (!first && record.inputSize != loaded[l - 1].outputSize) || !(record.outputScale > 0)) {
+            throw std::runtime_error(path + " is corrupted");
+        }
+
+        QLayer& layer = loaded[l];
+        layer.inputSize = record.inputSize;
+        layer.outputSize = record.outputSize;
+        layer.activation = static_cast<ActivationType>(record.activation);
+        layer.stride = record.stride;
+        layer.outputScale = record.outputScale;
+        layer.weights.resize(static_cast<std::size_t>(first ? layer.inputSize : layer.outputSize) * layer.stride);
+        layer.scales.resize(layer.outputSize);
+        layer.biases.resize(layer.outputSize);
+        file.read(reinterpret_cast<char*>(layer.weights.data()), layer.weights.size());
+        file.read(reinterpret_cast<char*>(layer.scales.data()), layer.scales.size() * sizeof(float));
+        file.read(reinterpret_cast<char*>(layer.biases.data()), layer.biases.size() * sizeof(std::int32_t));
+        if (!file) throw std::runtime_error(path + " is truncated");
+    }
+    layers = std::move(loaded);
+    mode = static_cast<Granularity>(header.granularity);
+    allocateBuffers();
+}
+
+} // namespace nn
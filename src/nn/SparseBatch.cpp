@@ -0,0 +1,46 @@
+#include "SparseBatch.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace nn {
+
+SparseBatch::SparseBatch(int cols) : numCols(cols) {}
+
+void SparseBatch::clear(int cols) {
+    numCols = cols;
+    offsets.assign(1, 0);
+    indices.clear();
+}
+
+void SparseBatch::addRow(std::span<const int> activeIndices) {
+    for (int j : activeIndices) {
+        if (static_cast<unsigned>(j) >= static_cast<unsigned>(numCols)) {
+            throw std::out_of_range("Sparse feature index " + std::to_string(j) + " out of range [0, " +
+                                    std::to_string(numCols) + ")");
+        }
+    }
+    indices.insert(indices.end(), activeIndices.begin(), activeIndices.end());
+    offsets.push_back(static_cast<int>(indices.size()));
+}
+
+SparseBatch SparseBatch::fromDense(const Matrix& dense) {
+    SparseBatch batch(dense.cols());
+    for (int b = 0; b < dense.rows(); ++b) {
+        auto r = dense.row(b);
+        for (int j = 0; j < dense.cols(); ++j) {
+            if (r[j] != Scalar(0)) batch.indices.push_back(j);
+        }
+        batch.offsets.push_back(static_cast<int>(batch.indices.size()));
+    }
+    return batch;
+}
+
+Matrix SparseBatch::toDense() const {
+    Matrix dense(rows(), numCols);
+    for (int b = 0; b < rows(); ++b) {
+        for (int j : row(b)) dense(b, j) = 1;
+    }
+    return dense;
+}
+
+} // namespace nn
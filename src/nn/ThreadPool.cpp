@@ -0,0 +1,77 @@
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+namespace nn {
+
+ThreadPool::ThreadPool(int threads) {
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) return;
+    if (workers.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &task;
+        taskCount = count;
+        nextTask = 0;
+        busyWorkers = static_cast<int>(workers.size());
+        error = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    current = nullptr;
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::runTasks() {
+    for (int i = nextTask++; i < taskCount; i = nextTask++) {
+        try {
+            (*current)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    trace::setThreadName("pool worker");
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        runTasks();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --busyWorkers;
+        }
+        done.notify_one();
+    }
+}
+
+} // namespace nn
@@ -0,0 +1,254 @@
+#include "Trace.hpp"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace nn::trace {
+
+namespace {
+
+constexpr int COUNTERS = 3;                    // cycles, instructions, défauts LLC
+constexpr std::size_t MAX_EVENTS = 1 << 18;    // Par thread, réservés d'avance ; au-delà les spans sont ignorés
+
+std::uint64_t now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+struct Event {
+    const char* name;
+    int arg;
+    bool counters;
+    std::uint64_t begin;
+    std::uint64_t end;                         // 0 : span non terminé, ignoré à l'écriture
+    std::uint64_t values[COUNTERS];
+};
+
+namespace {
+
+// Tampon d'un thread : seul son thread y écrit. La capacité est réservée à l'enregistrement du
+// thread : un span n'alloue jamais et les adresses des événements restent valides pendant que
+// des spans imbriqués en ajoutent d'autres.
+struct ThreadBuffer {
+    int tid = 0;
+    const char* name = nullptr;
+    std::vector<Event> events;
+    int fds[COUNTERS] = {-1, -1, -1};          // Groupe perf_event, fds[0] est le leader
+    bool perfTried = false;
+    bool inUse = true;                         // Faux une fois son thread terminé : réutilisable
+};
+
+std::mutex registryMutex;                      // Enregistrement des threads et écriture seulement
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+std::ofstream output;
+std::uint64_t origin = 0;
+std::atomic<std::size_t> dropped{0};
+std::atomic<int> counterThreads{0};            // Threads dont le groupe perf_event a été ouvert
+
+void closeCounters(ThreadBuffer& buffer) {
+    for (int& fd : buffer.fds) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    buffer.perfTried = false;
+}
+
+bool sameName(const char* a, const char* b) {
+    return a == b || (a && b && std::strcmp(a, b) == 0);
+}
+
+// Rend le tampon du thread à la fin de celui-ci. Ses événements restent jusqu'au prochain stop() ;
+// le prochain thread du même nom (un prefetcher par passe, par exemple) reprend le tampon et sa
+// ligne dans la trace au lieu d'en réserver un nouveau. Les compteurs, propres au thread, sont fermés.
+struct BufferOwner {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferOwner() {
+        if (!buffer) return;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        closeCounters(*buffer);
+        buffer->inUse = false;
+    }
+};
+
+thread_local BufferOwner localOwner;
+thread_local const char* localName = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    ThreadBuffer*& local = localOwner.buffer;
+    if (!local) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& buffer : buffers) {
+            if (!buffer->inUse && sameName(buffer->name, localName)) {
+                local = buffer.get();
+                break;
+            }
+        }
+        if (!local) {
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            local = buffers.back().get();
+            local->events.reserve(MAX_EVENTS);
+            local->tid = static_cast<int>(buffers.size());
+            local->name = localName;
+        }
+        local->inUse = true;
+    }
+    if (localName) local->name = localName;
+    return *local;
+}
+
+int openCounter(std::uint32_t type, std::uint64_t config, int group) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+// Groupe cycles / instructions / défauts LLC du thread courant, ouvert au premier besoin.
+// Un échec ne concerne que ce thread : les autres gardent leurs compteurs.
+bool openCounters(ThreadBuffer& buffer) {
+    if (buffer.perfTried) return buffer.fds[0] >= 0;
+    buffer.perfTried = true;
+
+    buffer.fds[0] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (buffer.fds[0] >= 0) {
+        buffer.fds[1] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, buffer.fds[0]);
+        buffer.fds[2] = openCounter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16), buffer.fds[0]);
+        // Certains CPU n'exposent pas l'événement LLC générique
+        if (buffer.fds[2] < 0) buffer.fds[2] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, buffer.fds[0]);
+    }
+    if (buffer.fds[0] < 0 || buffer.fds[1] < 0 || buffer.fds[2] < 0) {
+        closeCounters(buffer);
+        buffer.perfTried = true;
+        return false;
+    }
+    counterThreads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool readCounters(const ThreadBuffer& buffer, std::uint64_t values[COUNTERS]) {
+    struct {
+        std::uint64_t count;
+        std::uint64_t values[COUNTERS];
+    } group{};
+    if (read(buffer.fds[0], &group, sizeof(group)) != static_cast<ssize_t>(sizeof(group)) || group.count != COUNTERS) {
+        return false;
+    }
+    for (int c = 0; c < COUNTERS; ++c) values[c] = group.values[c];
+    return true;
+}
+
+void writeEvent(std::ostream& out, const ThreadBuffer& buffer, const Event& event, bool& first) {
+    char name[96];
+    if (event.arg >= 0) std::snprintf(name, sizeof(name), "%s L%d", event.name, event.arg + 1);
+    else std::snprintf(name, sizeof(name), "%s", event.name);
+
+    char line[512];
+    int length = std::snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                               first ? "" : ",\n", name, buffer.tid, (event.begin - origin) * 1e-3,
+                               (event.end - event.begin) * 1e-3);
+    if (event.counters) {
+        const double ipc = event.values[0] ? static_cast<double>(event.values[1]) / event.values[0] : 0.0;
+        length += std::snprintf(line + length, sizeof(line) - length,
+                                ",\"args\":{\"cycles\":%llu,\"instructions\":%llu,\"llc_misses\":%llu,\"ipc\":%.3f}",
+                                static_cast<unsigned long long>(event.values[0]),
+                                static_cast<unsigned long long>(event.values[1]),
+                                static_cast<unsigned long long>(event.values[2]), ipc);
+    }
+    out << line << "}";
+    first = false;
+}
+
+} // namespace
+
+void start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    output.open(path, std::ios::trunc);
+    if (!output) throw std::runtime_error("Cannot open trace file " + path);
+    // Les tampons restent enregistrés (leurs threads y pointent), seuls les événements sont effacés
+    for (auto& buffer : buffers) buffer->events.clear();
+    dropped.store(0, std::memory_order_relaxed);
+    origin = now();
+    active.store(true, std::memory_order_release);
+}
+
+std::size_t stop() {
+    if (!active.exchange(false)) return 0;
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::size_t written = 0;
+    bool first = true;
+    output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    for (const auto& buffer : buffers) {
+        if (buffer->events.empty()) continue;
+        char meta[160];
+        std::snprintf(meta, sizeof(meta), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                      first ? "" : ",\n", buffer->tid, buffer->name ? buffer->name : "main");
+        output << meta;
+        first = false;
+        for (const Event& event : buffer->events) {
+            if (event.end == 0) continue;
+            writeEvent(output, *buffer, event, first);
+            written++;
+        }
+    }
+    output << "\n],\"otherData\":{\"hardware_counters\":" << (countersAvailable() ? "true" : "false")
+           << ",\"dropped_events\":" << dropped.load() << "}}\n";
+    output.close();
+    return written;
+}
+
+bool countersAvailable() {
+    return counterThreads.load(std::memory_order_relaxed) > 0;
+}
+
+void setThreadName(const char* name) {
+    localName = name;
+    if (localOwner.buffer) localOwner.buffer->name = name;
+}
+
+void Span::begin(const char* name, int arg, bool counters) {
+    ThreadBuffer& buffer = threadBuffer();
+    if (buffer.events.size() >= MAX_EVENTS) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event& event = buffer.events.emplace_back();
+    event.name = name;
+    event.arg = arg;
+    event.counters = counters && openCounters(buffer) && readCounters(buffer, event.values);
+    event.end = 0;
+    event.begin = now();
+    slot = &event;
+}
+
+void Span::end() {
+    Event& event = *slot;
+    event.end = now();
+    if (event.counters) {
+        std::uint64_t values[COUNTERS];
+        if (readCounters(*localOwner.buffer, values)) {
+            for (int c = 0; c < COUNTERS; ++c) event.values[c] = values[c] - event.values[c];
+        } else {
+            event.counters = false;
+        }
+    }
+}
+
+} // namespace nn::trace
@@ -3,11 +3,23 @@
 
 namespace nn {
 
+namespace {
+
+std::mt19937& generator() {
+    static std::mt19937 gen(std::random_device{}());
+    return gen;
+}
+
+} // namespace
+
 double Utils::randomWeight(double min, double max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(min, max);
-    return dis(gen);
+    return dis(generator());
+}
+
+void Utils::seed(std::uint64_t value) {
+    std::seed_seq sequence{static_cast<std::uint32_t>(value), static_cast<std::uint32_t>(value >> 32)};
+    generator().seed(sequence);
 }
 
 } // namespace nn
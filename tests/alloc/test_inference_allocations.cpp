@@ -0,0 +1,68 @@
+#include "../unit_test.hpp"
+#include "../../include/Network.hpp"
+#include "../../include/FENParser.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Compteur d'allocations : remplace l'operator new global, d'où un exécutable à part (run_alloc_tests)
+namespace {
+std::atomic<long> allocationCount{0};
+
+void* countedAlloc(std::size_t size, std::size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size) { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t a) { return countedAlloc(size, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t size, std::align_val_t a) { return countedAlloc(size, static_cast<std::size_t>(a)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+TEST(InferenceSteadyStateDoesNotAllocate) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 64, nn::ActivationType::RELU);
+    net.addLayer(64, 32, nn::ActivationType::RELU);
+    net.addLayer(32, 3, nn::ActivationType::SOFTMAX);
+
+    int indices[analyzer::FENParser::MAX_ACTIVE];
+    const int count = analyzer::FENParser::toIndices("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", indices);
+    ASSERT_TRUE(count > 0);
+    const std::span<const int> active(indices, count);
+    nn::Vector dense(analyzer::FENParser::FEATURE_COUNT, 0.0);
+    for (int j : active) dense[j] = 1.0;
+
+    nn::InferenceWorkspace ws = net.makeWorkspace();
+    net.infer(active);  // Premier appel : crée le workspace du réseau
+
+    const long before = allocationCount.load();
+    nn::Scalar sum = 0;
+    for (int r = 0; r < 100; ++r) {
+        sum += net.infer(active)[0];
+        sum += net.infer(std::span<const nn::Scalar>(dense))[1];
+        sum += net.infer(active, ws)[2];
+        sum += net.infer(std::span<const nn::Scalar>(dense), ws)[0];
+    }
+    ASSERT_EQ(allocationCount.load() - before, 0);
+    ASSERT_TRUE(sum > 0);
+
+    // Le compteur voit bien les allocations du chemin historique
+    const long legacy = allocationCount.load();
+    net.forward(dense);
+    ASSERT_TRUE(allocationCount.load() > legacy);
+}
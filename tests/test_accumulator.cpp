@@ -0,0 +1,106 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/Accumulator.hpp"
+#include "../include/FENParser.hpp"
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr double TOLERANCE = std::is_same_v<nn::Scalar, float> ? 1e-4 : 1e-10;
+
+// 1. e4 e5 2. Nf3 Nc6 3. Bb5
+const std::vector<std::string> GAME = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+    "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq e6 0 2",
+    "rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+};
+
+std::vector<int> indicesOf(const std::string& fen) {
+    std::vector<int> indices;
+    analyzer::FENParser::fenToIndices(fen, indices);
+    return indices;
+}
+
+} // namespace
+
+TEST(AccumulatorTransitionsMatchFullForward) {
+    nn::Network net = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 32, 16, 3}, nn::ActivationType::SIGMOID);
+    nn::Accumulator acc(net);
+    std::vector<int> previous = indicesOf(GAME[0]);
+    acc.refresh(previous);
+
+    for (const auto& fen : GAME) {
+        std::vector<int> current = indicesOf(fen);
+        acc.transition(previous, current);
+        previous = current;
+
+        auto incremental = acc.evaluate();
+        auto full = net.forward(analyzer::FENParser::fenToVector(fen));
+        ASSERT_EQ(incremental.size(), full.size());
+        for (size_t k = 0; k < full.size(); ++k) ASSERT_NEAR(incremental[k], full[k], TOLERANCE);
+    }
+    ASSERT_TRUE(acc.updatesSinceRefresh() > 0);
+}
+
+TEST(AccumulatorMoveUpdateMatchesRefresh) {
+    using analyzer::FENParser;
+    nn::Network net = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 32, 16, 3}, nn::ActivationType::SIGMOID);
+    nn::Accumulator parent(net);
+    parent.refresh(indicesOf(GAME[2]));
+
+    // 2. Nf3 : g1 (62) se vide, f3 (45) reçoit le cavalier, le trait passe aux noirs, en passant disparaît
+    nn::Accumulator child = parent;
+    const int removed[] = {FENParser::featureIndex(62, 'N'), FENParser::featureIndex(45, ' '), 832, 837};
+    const int added[] = {FENParser::featureIndex(62, ' '), FENParser::featureIndex(45, 'N')};
+    child.update(added, removed);
+
+    nn::Accumulator fresh(net);
+    fresh.refresh(indicesOf(GAME[3]));
+    for (size_t i = 0; i < fresh.preActivation().size(); ++i) {
+        ASSERT_NEAR(child.preActivation()[i], fresh.preActivation()[i], TOLERANCE);
+    }
+
+    // Le parent n'a pas bougé
+    nn::Accumulator original(net);
+    original.refresh(indicesOf(GAME[2]));
+    for (size_t i = 0; i < original.preActivation().size(); ++i) {
+        ASSERT_NEAR(parent.preActivation()[i], original.preActivation()[i], TOLERANCE);
+    }
+}
+
+TEST(AccumulatorRejectsOutOfRangeFeatures) {
+    nn::Network net = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 8, 3}, nn::ActivationType::SIGMOID);
+    nn::Accumulator acc(net);
+    const int outOfRange[] = {0, analyzer::FENParser::FEATURE_COUNT};
+    const int negative[] = {-1};
+    const int none[] = {0};
+
+    int thrown = 0;
+    auto expectThrow = [&](auto&& call) {
+        try {
+            call();
+        } catch (const std::out_of_range&) {
+            ++thrown;
+        }
+    };
+    expectThrow([&] { acc.add(analyzer::FENParser::FEATURE_COUNT); });
+    expectThrow([&] { acc.remove(-1); });
+    expectThrow([&] { acc.refresh(outOfRange); });
+    expectThrow([&] { acc.update(negative, {}); });
+    expectThrow([&] { acc.transition(none, outOfRange); });
+    ASSERT_EQ(thrown, 5);
+
+    nn::Network empty;
+    bool threw = false;
+    try {
+        nn::Accumulator invalid(empty);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
@@ -0,0 +1,76 @@
+#include "unit_test.hpp"
+#include "../include/Network.hpp"
+#include "../include/Loss.hpp"
+#include <vector>
+#include <type_traits>
+
+namespace {
+
+// Les sommes ne sont pas faites dans le même ordre : tolérance selon le type scalaire
+constexpr double TOLERANCE = std::is_same_v<nn::Scalar, float> ? 1e-5 : 1e-12;
+
+std::vector<nn::Vector> makeSamples(int count, int size) {
+    std::vector<nn::Vector> samples;
+    for (int s = 0; s < count; ++s) {
+        nn::Vector in(size);
+        for (int j = 0; j < size; ++j) in[j] = ((s * 7 + j * 3) % 11) / 10.0 - 0.5;
+        samples.push_back(in);
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST(BatchForwardMatchesSingle) {
+    nn::Network net;
+    net.addLayer(10, 8, nn::ActivationType::RELU);
+    net.addLayer(8, 3, nn::ActivationType::SOFTMAX);
+
+    auto samples = makeSamples(7, 10); // 7 : couvre le bloc de 4 et le reste
+    nn::Matrix batch(7, 10);
+    for (int b = 0; b < 7; ++b) std::copy(samples[b].begin(), samples[b].end(), batch.row(b).begin());
+
+    nn::Matrix out = net.forwardBatch(batch);
+    ASSERT_EQ(out.rows(), 7);
+    ASSERT_EQ(out.cols(), 3);
+    for (int b = 0; b < 7; ++b) {
+        auto single = net.forward(samples[b]);
+        for (int k = 0; k < 3; ++k) ASSERT_NEAR(out(b, k), single[k], TOLERANCE);
+    }
+}
+
+TEST(BatchGradientsMatchAccumulated) {
+    nn::Network reference;
+    reference.addLayer(10, 6, nn::ActivationType::RELU);
+    reference.addLayer(6, 5, nn::ActivationType::SIGMOID);
+    reference.addLayer(5, 2, nn::ActivationType::SIGMOID);
+    nn::Network batched = reference;
+
+    auto samples = makeSamples(6, 10);
+    nn::Vector target = {1.0, 0.0};
+
+    for (const auto& in : samples) {
+        auto out = reference.forward(in);
+        reference.accumulateGradients(nn::loss::crossEntropyDerivative(out, target));
+    }
+    reference.updateWeights(0.5, 6);
+
+    nn::Matrix batch(6, 10);
+    for (int b = 0; b < 6; ++b) std::copy(samples[b].begin(), samples[b].end(), batch.row(b).begin());
+    nn::Matrix out = batched.forwardBatch(batch);
+    nn::Matrix grad(6, 2);
+    for (int b = 0; b < 6; ++b) {
+        auto g = nn::loss::crossEntropyDerivative({out(b, 0), out(b, 1)}, target);
+        grad(b, 0) = g[0];
+        grad(b, 1) = g[1];
+    }
+    batched.backwardBatch(grad);
+    batched.updateWeights(0.5, 6);
+
+    // Mêmes gradients => mêmes poids => mêmes sorties
+    for (const auto& in : samples) {
+        auto a = reference.forward(in);
+        auto b = batched.forward(in);
+        for (size_t k = 0; k < a.size(); ++k) ASSERT_NEAR(a[k], b[k], TOLERANCE);
+    }
+}
@@ -0,0 +1,104 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/Checkpoint.hpp"
+#include "../include/Network.hpp"
+#include "../include/Optimizer.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::unique_ptr<nn::Optimizer> makeAdam() {
+    nn::OptimizerOptions options;
+    options.type = nn::OptimizerType::ADAMW;
+    options.weightDecay = 0.01;
+    return nn::Optimizer::create(options);
+}
+
+} // namespace
+
+TEST(CheckpointResumeIsExact) {
+    // Reprendre depuis un checkpoint donne exactement les mêmes poids qu'un entraînement continu
+    const std::string dir = "test_checkpoint_resume";
+    fs::remove_all(dir);
+    nn::Matrix inputs, targets;
+    test_helpers::makeBatch(inputs, targets, 8, 10);
+
+    nn::Network net = test_helpers::makeNetwork({10, 6, 3});
+    auto optimizer = makeAdam();
+    nn::ParallelTrainer trainer(net, 1, optimizer.get());
+    for (int step = 0; step < 3; ++step) trainer.trainBatch(inputs, targets, 0.01);
+
+    analyzer::TrainingState state;
+    state.epoch = 3;
+    state.learningRate = 0.0123456789012345;
+    state.monitor = "val_loss";
+    state.best = 0.1 + 0.2;
+    state.staleEpochs = 1;
+    analyzer::checkpoint::write(dir, net, *optimizer, state, 0);
+    for (int step = 0; step < 3; ++step) trainer.trainBatch(inputs, targets, 0.01);
+
+    nn::Network resumed = test_helpers::makeNetwork({10, 6, 3});
+    auto resumedOptimizer = makeAdam();
+    analyzer::TrainingState loaded = analyzer::checkpoint::read(dir, resumed, *resumedOptimizer);
+    ASSERT_EQ(loaded.epoch, 3);
+    ASSERT_TRUE(loaded.learningRate == state.learningRate);
+    ASSERT_TRUE(loaded.best == state.best);
+    ASSERT_TRUE(loaded.monitor == "val_loss");
+    ASSERT_EQ(loaded.staleEpochs, 1);
+    ASSERT_TRUE(resumedOptimizer->steps() == 3);
+
+    nn::ParallelTrainer resumedTrainer(resumed, 1, resumedOptimizer.get());
+    for (int step = 0; step < 3; ++step) resumedTrainer.trainBatch(inputs, targets, 0.01);
+    ASSERT_TRUE(test_helpers::sameWeights(net, resumed));
+    fs::remove_all(dir);
+}
+
+TEST(CheckpointKeepsLatest) {
+    const std::string dir = "test_checkpoint_keep";
+    fs::remove_all(dir);
+    nn::Network net = test_helpers::makeNetwork({10, 6, 3});
+    auto optimizer = makeAdam();
+
+    analyzer::TrainingState state;
+    state.monitor = "val_acc";
+    for (int epoch = 1; epoch <= 4; ++epoch) {
+        state.epoch = epoch;
+        analyzer::checkpoint::write(dir, net, *optimizer, state, 2);
+    }
+    ASSERT_TRUE(!fs::exists(dir + "/checkpoint-0001"));
+    ASSERT_TRUE(!fs::exists(dir + "/checkpoint-0002"));
+    ASSERT_TRUE(fs::exists(dir + "/checkpoint-0003/model.nn"));
+    ASSERT_TRUE(!fs::exists(dir + "/checkpoint-0004.tmp"));
+
+    // Le répertoire reprend le dernier, un checkpoint nommé est repris tel quel
+    nn::Network resumed;
+    ASSERT_EQ(analyzer::checkpoint::read(dir, resumed, *optimizer).epoch, 4);
+    ASSERT_EQ(analyzer::checkpoint::read(dir + "/checkpoint-0003", resumed, *optimizer).epoch, 3);
+    ASSERT_TRUE(test_helpers::sameWeights(net, resumed));
+
+    // Processus tué pendant le remplacement du dernier checkpoint : seul le .old existe encore
+    fs::rename(dir + "/checkpoint-0004", dir + "/checkpoint-0004.old");
+    ASSERT_EQ(analyzer::checkpoint::read(dir, resumed, *optimizer).epoch, 4);
+    analyzer::checkpoint::write(dir, net, *optimizer, state, 2);
+    ASSERT_TRUE(fs::exists(dir + "/checkpoint-0004/state"));
+    ASSERT_TRUE(!fs::exists(dir + "/checkpoint-0004.old"));
+    // Réécrire le checkpoint nommé par latest ne laisse rien derrière
+    analyzer::checkpoint::write(dir, net, *optimizer, state, 2);
+    ASSERT_TRUE(!fs::exists(dir + "/checkpoint-0004.old"));
+    ASSERT_EQ(analyzer::checkpoint::read(dir, resumed, *optimizer).epoch, 4);
+
+    bool threw = false;
+    try {
+        analyzer::checkpoint::read(dir + "/missing", resumed, *optimizer);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    fs::remove_all(dir);
+}
@@ -0,0 +1,148 @@
+#include "unit_test.hpp"
+#include "../include/DataSource.hpp"
+#include "../include/Prefetcher.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const char* const FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3",
+    "4k3/8/8/3pP3/8/8/8/4K2R w K d6 0 1",
+};
+const char* const LABELS[] = {"Nothing", "Check", "Checkmate"};
+
+bool sameBatch(const analyzer::Minibatch& a, const analyzer::Minibatch& b) {
+    if (a.inputs.rows() != b.inputs.rows() || a.targets.cols() != b.targets.cols()) return false;
+    for (int r = 0; r < a.inputs.rows(); ++r) {
+        auto ra = a.inputs.row(r), rb = b.inputs.row(r);
+        if (!std::equal(ra.begin(), ra.end(), rb.begin(), rb.end())) return false;
+        for (int k = 0; k < a.targets.cols(); ++k) {
+            if (a.targets(r, k) != b.targets(r, k)) return false;
+        }
+    }
+    return true;
+}
+
+// Échoue au troisième batch
+class FailingSource : public analyzer::DataSource {
+public:
+    std::size_t size() const override { return 10; }
+    int classCount() const override { return 3; }
+    int label(std::size_t) const override { return 0; }
+    void fill(std::span<const std::size_t> rows, analyzer::Minibatch& batch) const override {
+        if (rows.front() >= 4) throw std::runtime_error("read error");
+        batch.inputs.clear(4);
+        batch.targets.resize(static_cast<int>(rows.size()), 3);
+    }
+};
+
+} // namespace
+
+TEST(DataSourcesProduceIdenticalBatches) {
+    const std::string text = "test_data_source.txt";
+    const std::string packed = "test_data_source.mtds";
+    {
+        std::ofstream file(text);
+        for (int i = 0; i < 23; ++i) {
+            file << FENS[i % 3] << ";" << LABELS[(i / 3) % 3] << "\n";
+            if (i == 7) file << "not a sample\n"; // Ignorée par toutes les sources
+        }
+    }
+    analyzer::PackedDataset::pack(text, packed);
+
+    auto memory = analyzer::DataSource::open(text, false);
+    auto stream = analyzer::DataSource::open(text, true);
+    auto mapped = analyzer::DataSource::open(packed, false);
+    ASSERT_EQ(memory->size(), (size_t)23);
+    ASSERT_EQ(stream->size(), (size_t)23);
+    ASSERT_EQ(mapped->size(), (size_t)23);
+    ASSERT_EQ(stream->classCount(), 3);
+
+    analyzer::Prefetcher fromMemory(*memory, 2, 23, 5);
+    analyzer::Prefetcher fromStream(*stream, 2, 23, 5);
+    analyzer::Prefetcher fromPacked(*mapped, 2, 23, 5);
+    int batches = 0, rows = 0;
+    while (const analyzer::Minibatch* expected = fromMemory.next()) {
+        const analyzer::Minibatch* a = fromStream.next();
+        const analyzer::Minibatch* b = fromPacked.next();
+        ASSERT_TRUE(a != nullptr && b != nullptr);
+        ASSERT_TRUE(sameBatch(*expected, *a));
+        ASSERT_TRUE(sameBatch(*expected, *b));
+        rows += expected->inputs.rows();
+        batches++;
+    }
+    ASSERT_EQ(batches, 5);
+    ASSERT_EQ(rows, 21);
+    ASSERT_TRUE(fromStream.next() == nullptr);
+    ASSERT_TRUE(fromPacked.next() == nullptr);
+
+    // Ordre mélangé : mêmes lignes dans toutes les sources, le flux lit les suites contiguës d'un coup
+    const std::vector<std::size_t> order = {5, 6, 7, 0, 22, 3, 4, 11, 1};
+    analyzer::Prefetcher shuffledMemory(*memory, order, 4);
+    analyzer::Prefetcher shuffledStream(*stream, order, 4);
+    analyzer::Prefetcher shuffledPacked(*mapped, order, 4);
+    while (const analyzer::Minibatch* expected = shuffledMemory.next()) {
+        ASSERT_TRUE(sameBatch(*expected, *shuffledStream.next()));
+        ASSERT_TRUE(sameBatch(*expected, *shuffledPacked.next()));
+    }
+    analyzer::Minibatch single;
+    const std::size_t last[] = {22};
+    memory->fill(last, single);
+    ASSERT_TRUE(single.targets(0, memory->label(22)) == 1);
+    ASSERT_EQ(stream->label(22), memory->label(22));
+    ASSERT_EQ(mapped->label(22), memory->label(22));
+
+    std::remove(text.c_str());
+    std::remove(packed.c_str());
+}
+
+TEST(PrefetcherRethrowsSourceErrors) {
+    FailingSource source;
+    analyzer::Prefetcher batches(source, 0, source.size(), 2);
+    bool threw = false;
+    int seen = 0;
+    try {
+        while (batches.next()) seen++;
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_TRUE(seen <= 2);
+}
+
+TEST(StratifiedSplitKeepsClassProportions) {
+    // Fichier trié par classe : 60 / 30 / 10 échantillons
+    const std::string text = "test_stratified_split.txt";
+    {
+        std::ofstream file(text);
+        for (int i = 0; i < 100; ++i) file << FENS[i % 3] << ";" << LABELS[i < 60 ? 0 : i < 90 ? 1 : 2] << "\n";
+    }
+    auto source = analyzer::DataSource::open(text, false);
+
+    std::mt19937_64 rng(7);
+    const analyzer::Split split = analyzer::stratifiedSplit(*source, 0.2, rng);
+    ASSERT_EQ(split.train.size(), (size_t)80);
+    ASSERT_EQ(split.validation.size(), (size_t)20);
+    int perClass[3] = {0, 0, 0};
+    for (std::size_t i : split.validation) perClass[source->label(i)]++;
+    ASSERT_EQ(perClass[0], 12);
+    ASSERT_EQ(perClass[1], 6);
+    ASSERT_EQ(perClass[2], 2);
+
+    // Partition complète, triée, et reproductible pour une même graine
+    std::vector<std::size_t> all = split.train;
+    all.insert(all.end(), split.validation.begin(), split.validation.end());
+    std::sort(all.begin(), all.end());
+    for (std::size_t i = 0; i < all.size(); ++i) ASSERT_EQ(all[i], i);
+    ASSERT_TRUE(std::is_sorted(split.train.begin(), split.train.end()));
+    std::mt19937_64 again(7);
+    ASSERT_TRUE(analyzer::stratifiedSplit(*source, 0.2, again).validation == split.validation);
+
+    std::remove(text.c_str());
+}
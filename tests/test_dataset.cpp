@@ -2,6 +2,7 @@
 #include "../include/Dataset.hpp"
 #include <fstream>
 #include <cstdio>
+#include <filesystem>
 
 TEST(DatasetLoaderTest) {
     // Create a temporary CSV file
@@ -31,3 +32,48 @@ TEST(DatasetLoaderTest) {
     // Cleanup
     std::remove(filename.c_str());
 }
+
+TEST(DatasetParallelMultiFileLoad) {
+    // Deux fichiers dans des sous-répertoires et un fichier binaire que le parcours doit ignorer
+    const std::string root = "test_dataset_dir";
+    std::filesystem::create_directories(root + "/check");
+    std::filesystem::create_directories(root + "/checkmate");
+    const char* labels[] = {"Nothing", "Check", "Checkmate"};
+    size_t expected = 0;
+    for (const char* dir : {"check", "checkmate"}) {
+        std::ofstream file(root + "/" + dir + "/positions.txt");
+        for (int i = 0; i < 12000; ++i) {
+            file << "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - " << i << " 1 " << labels[i % 3] << "\n";
+            expected++;
+            if (i % 1000 == 0) file << "garbage line\n";
+        }
+    }
+    {
+        std::ofstream packed(root + "/check/positions.mtds", std::ios::binary);
+        const char header[8] = {'M', 'T', 'D', 'S', 1, 0, 0, 0};
+        packed.write(header, sizeof(header));
+    }
+
+    auto files = analyzer::Dataset::expandPaths(root);
+    ASSERT_EQ(files.size(), (size_t)2);
+    ASSERT_TRUE(files[0] < files[1]);
+    ASSERT_EQ(analyzer::Dataset::expandPaths(root + "/*/positions.txt"), files);
+    ASSERT_TRUE(analyzer::Dataset::expandPaths(root + "/*.csv").empty());
+
+    auto serial = analyzer::Dataset::loadSparse(root, 1);
+    auto parallel = analyzer::Dataset::loadSparse(root + "/*/positions.txt", 4);
+    // Tranches de 1000 octets : les coupures tombent au milieu des lignes (~70 octets)
+    auto chunked = analyzer::Dataset::loadSparse(root, 4, analyzer::FeatureExtractor(), 1000);
+    ASSERT_EQ(serial.size(), expected);
+    ASSERT_EQ(parallel.size(), expected);
+    ASSERT_EQ(chunked.size(), expected);
+    for (size_t i = 0; i < serial.size(); ++i) {
+        ASSERT_TRUE(serial[i].indices == parallel[i].indices);
+        ASSERT_TRUE(serial[i].target == parallel[i].target);
+        ASSERT_TRUE(serial[i].indices == chunked[i].indices);
+        ASSERT_TRUE(serial[i].target == chunked[i].target);
+        ASSERT_EQ(serial[i].target[(i % 12000) % 3], 1.0);
+    }
+
+    std::filesystem::remove_all(root);
+}
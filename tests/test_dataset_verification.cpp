@@ -38,12 +38,12 @@ TEST(DatasetVerification) {
     net.addLayer(inputSize, 64, nn::ActivationType::RELU);
     net.addLayer(64, outputSize, nn::ActivationType::SIGMOID);
     
-    std::vector<std::pair<std::vector<double>, std::vector<double>>> dataset;
+    std::vector<std::pair<nn::Vector, nn::Vector>> dataset;
     
     // Generate synthetic data
     for(int i=0; i<samples; ++i) {
-        std::vector<double> in(inputSize, 0.0);
-        std::vector<double> out(outputSize, 0.0);
+        nn::Vector in(inputSize, 0.0);
+        nn::Vector out(outputSize, 0.0);
         
         in[i % inputSize] = 1.0; // One-hot-ish
         out[i % outputSize] = 1.0; // Class
@@ -1,10 +1,12 @@
 #include "unit_test.hpp"
 #include "../include/FENParser.hpp"
+#include <string>
+#include <vector>
 
 TEST(FENParserTest) {
     // Start position
     std::string startFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
-    std::vector<double> vec = analyzer::FENParser::fenToVector(startFen);
+    nn::Vector vec = analyzer::FENParser::fenToVector(startFen);
     
     ASSERT_EQ(vec.size(), 838);
     
@@ -26,7 +28,7 @@ TEST(FENParserEmptyTest) {
     // Empty board (kings only for validity usually, but parser doesn't check validity)
     // 8/8/8/8/8/8/8/8 b - - 0 1
     std::string emptyFen = "8/8/8/8/8/8/8/8 b - - 0 1";
-    std::vector<double> vec = analyzer::FENParser::fenToVector(emptyFen);
+    nn::Vector vec = analyzer::FENParser::fenToVector(emptyFen);
     
     ASSERT_EQ(vec.size(), 838);
     ASSERT_EQ(vec[832], 0.0); // Black
@@ -36,3 +38,65 @@ TEST(FENParserEmptyTest) {
     ASSERT_EQ(vec[0], 1.0);
     ASSERT_EQ(vec[1], 0.0);
 }
+
+TEST(FENParserSpanMatchesLegacy) {
+    const char* fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "rnbqkbnr/pp1ppppp/8/2pP4/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 2",
+        "r3k2r/8/8/8/8/8/8/R3K2R b qkQK -",        // Roques dans le désordre, sans compteurs
+        "  8/8/8/8/8/8/8/8 b - - 0 1  ",           // Espaces autour
+        "8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59 Check", // Annotation d'un dataset brut
+    };
+    for (const char* fen : fens) {
+        int indices[analyzer::FENParser::MAX_ACTIVE];
+        const int count = analyzer::FENParser::toIndices(fen, indices);
+        ASSERT_TRUE(count >= 64);
+        for (int i = 1; i < count; ++i) ASSERT_TRUE(indices[i - 1] < indices[i]);
+
+        std::vector<int> legacy;
+        ASSERT_TRUE(analyzer::FENParser::fenToIndices(fen, legacy));
+        ASSERT_TRUE(std::vector<int>(indices, indices + count) == legacy);
+
+        nn::Vector features(analyzer::FENParser::FEATURE_COUNT, 5.0);
+        ASSERT_TRUE(analyzer::FENParser::toFeatures(fen, features));
+        ASSERT_TRUE(features == analyzer::FENParser::fenToVector(fen));
+        int ones = 0;
+        for (nn::Scalar f : features) ones += (f == 1.0);
+        ASSERT_EQ(ones, count);
+    }
+
+    int indices[analyzer::FENParser::MAX_ACTIVE];
+    ASSERT_EQ(analyzer::FENParser::toIndices("r3k2r/8/8/8/8/8/8/R3K2R b qkQK - 0 1", indices), 64 + 4);
+    ASSERT_EQ(indices[64], 833);
+    ASSERT_EQ(indices[67], 836);
+}
+
+TEST(FENParserRejectsMalformed) {
+    const char* invalid[] = {
+        "",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",            // 7 rangées
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1", // 9 rangées
+        "rnbqkbnr/ppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",    // Rangée courte
+        "rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",   // Chiffre hors 1-8
+        "rnbqkbnr/pppppppp/44p/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", // Rangée longue
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1",   // Pièce inconnue
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",                // Pas de trait
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkk - 0 1",   // Roque répété
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e5 0 1",  // En passant impossible
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq",         // Pas d'en passant
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - x 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 Check",
+    };
+    for (const char* fen : invalid) {
+        int indices[analyzer::FENParser::MAX_ACTIVE];
+        ASSERT_EQ(analyzer::FENParser::toIndices(fen, indices), -1);
+        std::vector<int> legacy;
+        ASSERT_TRUE(!analyzer::FENParser::fenToIndices(fen, legacy));
+        ASSERT_TRUE(legacy.empty());
+    }
+
+    // Tampon trop petit : refusé même si le FEN est valide
+    int small[10];
+    ASSERT_EQ(analyzer::FENParser::toIndices("8/8/8/8/8/8/8/8 b - - 0 1", small), -1);
+}
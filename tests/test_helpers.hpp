@@ -0,0 +1,50 @@
+#pragma once
+#include "../include/Matrix.hpp"
+#include "../include/Network.hpp"
+#include <initializer_list>
+#include <vector>
+
+// Fixtures partagées par les tests qui entraînent, sauvegardent ou comparent des réseaux
+namespace test_helpers {
+
+// Couches cachées en RELU, dernière couche en output (softmax : la dérivée p - y de
+// l'entropie croisée est alors exacte). makeNetwork({20, 8, 3}) : 20 -> 8 -> 3.
+inline nn::Network makeNetwork(std::initializer_list<int> sizes,
+                               nn::ActivationType output = nn::ActivationType::SOFTMAX) {
+    const std::vector<int> s(sizes);
+    nn::Network net;
+    for (size_t l = 0; l + 1 < s.size(); ++l) {
+        net.addLayer(s[l], s[l + 1], l + 2 == s.size() ? output : nn::ActivationType::RELU);
+    }
+    return net;
+}
+
+// Entrées déterministes dans [-1, 1], cible one-hot sur la classe b % classes
+inline void makeBatch(nn::Matrix& inputs, nn::Matrix& targets, int rows, int cols, int classes = 3) {
+    inputs.resize(rows, cols);
+    targets.resize(rows, classes);
+    for (int b = 0; b < rows; ++b) {
+        for (int j = 0; j < cols; ++j) inputs(b, j) = ((b * 5 + j * 7) % 13) / nn::Scalar(6) - 1;
+        targets(b, b % classes) = 1;
+    }
+}
+
+// Même topologie, mêmes activations et poids et biais identiques bit à bit
+inline bool sameWeights(const nn::Network& a, const nn::Network& b) {
+    if (a.layerCount() != b.layerCount()) return false;
+    for (size_t l = 0; l < a.layerCount(); ++l) {
+        const nn::Matrix& wa = a.layer(l).getWeights();
+        const nn::Matrix& wb = b.layer(l).getWeights();
+        if (wa.rows() != wb.rows() || wa.cols() != wb.cols()) return false;
+        if (a.layer(l).getActivationType() != b.layer(l).getActivationType()) return false;
+        for (int i = 0; i < wa.rows(); ++i) {
+            for (int j = 0; j < wa.cols(); ++j) {
+                if (wa(i, j) != wb(i, j)) return false;
+            }
+        }
+        if (a.layer(l).getBiases() != b.layer(l).getBiases()) return false;
+    }
+    return true;
+}
+
+} // namespace test_helpers
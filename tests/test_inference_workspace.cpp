@@ -0,0 +1,42 @@
+#include "unit_test.hpp"
+#include "../include/Network.hpp"
+#include <stdexcept>
+#include <vector>
+
+TEST(InferenceMatchesForward) {
+    nn::Network net;
+    net.addLayer(20, 16, nn::ActivationType::RELU);
+    net.addLayer(16, 8, nn::ActivationType::SIGMOID);
+    net.addLayer(8, 3, nn::ActivationType::SOFTMAX);
+
+    nn::Vector input(20, 0.0);
+    std::vector<int> active = {1, 4, 7, 19};
+    for (int j : active) input[j] = 1.0;
+
+    const nn::Vector expected = net.forward(input);
+    auto dense = net.infer(std::span<const nn::Scalar>(input));
+    ASSERT_EQ(dense.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) ASSERT_NEAR(dense[k], expected[k], 1e-5);
+
+    nn::InferenceWorkspace ws = net.makeWorkspace();
+    auto sparse = net.infer(std::span<const int>(active), ws);
+    for (size_t k = 0; k < expected.size(); ++k) ASSERT_NEAR(sparse[k], expected[k], 1e-5);
+
+    // Topologie modifiée : le workspace du réseau est redimensionné
+    net.addLayer(3, 2, nn::ActivationType::SIGMOID);
+    ASSERT_EQ(net.infer(std::span<const nn::Scalar>(input)).size(), 2);
+}
+
+TEST(InferenceRejectsWrongInputSize) {
+    nn::Network net;
+    net.addLayer(20, 4, nn::ActivationType::RELU);
+    net.addLayer(4, 3, nn::ActivationType::SOFTMAX);
+    const nn::Vector input(19, 1.0);
+    bool threw = false;
+    try {
+        net.infer(std::span<const nn::Scalar>(input));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
@@ -0,0 +1,149 @@
+#include "unit_test.hpp"
+#include "../include/Kernels.hpp"
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <typename T>
+std::vector<T> pattern(int n, int seed) {
+    std::vector<T> v(n);
+    for (int j = 0; j < n; ++j) v[j] = T(((j * 37 + seed * 11) % 23) / 11.0 - 1.0);
+    return v;
+}
+
+template <typename T>
+void checkAgainstScalar() {
+    using nn::kernels::Isa;
+    // Réductions sur 838 termes : l'ordre des sommes diffère du scalaire
+    const double dotTol = std::is_same_v<T, float> ? 1e-3 : 1e-9;
+    const double axpyTol = std::is_same_v<T, float> ? 1e-5 : 1e-12;
+
+    const auto* ref = nn::kernels::forIsa<T>(Isa::SCALAR);
+    ASSERT_TRUE(ref != nullptr);
+
+    for (Isa isa : {Isa::AVX2, Isa::AVX512}) {
+        const auto* k = nn::kernels::forIsa<T>(isa);
+        if (!k) continue; // CPU sans support : rien à comparer
+
+        // Tailles couvrant les queues de boucle et la largeur du premier layer
+        for (int n : {1, 3, 7, 8, 13, 17, 64, 838}) {
+            auto a = pattern<T>(n, 1), b = pattern<T>(n, 2);
+            std::vector<std::vector<T>> xs = {pattern<T>(n, 3), pattern<T>(n, 4), pattern<T>(n, 5), pattern<T>(n, 6)};
+            const T* x[4] = {xs[0].data(), xs[1].data(), xs[2].data(), xs[3].data()};
+            const T coeffs[4] = {T(0.5), T(-1.25), T(2.0), T(0.125)};
+
+            ASSERT_NEAR(k->dot(a.data(), b.data(), n), ref->dot(a.data(), b.data(), n), dotTol);
+
+            T out[4], outRef[4];
+            k->dot4(a.data(), x, n, out);
+            ref->dot4(a.data(), x, n, outRef);
+            for (int r = 0; r < 4; ++r) ASSERT_NEAR(out[r], outRef[r], dotTol);
+
+            auto y = b, yRef = b;
+            k->axpy(T(0.75), a.data(), y.data(), n);
+            ref->axpy(T(0.75), a.data(), yRef.data(), n);
+            for (int j = 0; j < n; ++j) ASSERT_NEAR(y[j], yRef[j], axpyTol);
+
+            y = b; yRef = b;
+            auto v = a, vRef = a;
+            k->axpy2(T(-0.5), xs[0].data(), y.data(), xs[1].data(), v.data(), n);
+            ref->axpy2(T(-0.5), xs[0].data(), yRef.data(), xs[1].data(), vRef.data(), n);
+            for (int j = 0; j < n; ++j) {
+                ASSERT_NEAR(y[j], yRef[j], axpyTol);
+                ASSERT_NEAR(v[j], vRef[j], axpyTol);
+            }
+
+            y = b; yRef = b;
+            k->axpy4(coeffs, x, y.data(), n);
+            ref->axpy4(coeffs, x, yRef.data(), n);
+            for (int j = 0; j < n; ++j) ASSERT_NEAR(y[j], yRef[j], axpyTol);
+
+            auto z = a;
+            for (T& zj : z) zj *= T(20);
+            k->sigmoid(z.data(), y.data(), n);
+            ref->sigmoid(z.data(), yRef.data(), n);
+            for (int j = 0; j < n; ++j) ASSERT_NEAR(y[j], yRef[j], axpyTol);
+
+            k->relu(z.data(), y.data(), n);
+            ref->relu(z.data(), yRef.data(), n);
+            for (int j = 0; j < n; ++j) ASSERT_EQ(y[j], yRef[j]);
+        }
+    }
+}
+
+} // namespace
+
+TEST(KernelsMatchScalarReference) {
+    checkAgainstScalar<double>();
+    checkAgainstScalar<float>();
+}
+
+template <typename T>
+void checkFastExp() {
+    using E = nn::kernels::ExpApprox<T>;
+    const double bound = std::is_same_v<T, float> ? 5e-7 : 1e-15;
+    double worst = 0.0;
+    for (int s = 0; s <= 200000; ++s) {
+        const T x = T(E::LO + (E::HI - E::LO) * s / 200000.0);
+        const double exact = std::exp(static_cast<double>(x));
+        worst = std::max(worst, std::abs(nn::kernels::fastExp(x) - exact) / exact);
+    }
+    ASSERT_TRUE(worst < bound);
+
+    // Hors de [LO, HI] : borné, jamais infini ni NaN
+    ASSERT_TRUE(std::isfinite(nn::kernels::fastExp(T(1e6))));
+    ASSERT_TRUE(nn::kernels::fastExp(T(-1e6)) > T(0));
+
+    for (auto isa : {nn::kernels::Isa::SCALAR, nn::kernels::Isa::AVX2, nn::kernels::Isa::AVX512}) {
+        const auto* k = nn::kernels::forIsa<T>(isa);
+        if (!k) continue;
+        std::vector<T> z = {T(-1000), T(-40), T(-3), T(-0.5), T(0), T(0.25), T(2), T(15), T(40), T(1000), T(0.1)};
+        std::vector<T> out(z.size());
+        k->sigmoid(z.data(), out.data(), static_cast<int>(z.size()));
+        for (size_t j = 0; j < z.size(); ++j) {
+            const double exact = 1.0 / (1.0 + std::exp(-static_cast<double>(z[j])));
+            ASSERT_NEAR(out[j], exact, 2 * bound);
+        }
+    }
+}
+
+TEST(FastExpErrorIsBounded) {
+    checkFastExp<double>();
+    checkFastExp<float>();
+}
+
+TEST(Int8KernelsMatchScalarReference) {
+    using nn::kernels::Isa;
+    const auto* ref = nn::kernels::int8ForIsa(Isa::SCALAR);
+    ASSERT_TRUE(ref != nullptr);
+
+    // Activations aux bornes [0, 127] et poids aux bornes [-127, 127] : aucun arrondi, égalité exacte
+    for (Isa isa : {Isa::AVX2, Isa::AVX512, Isa::AVX512VNNI}) {
+        const auto* k = nn::kernels::int8ForIsa(isa);
+        if (!k) continue;
+
+        for (int n : {64, 128, 896}) {
+            std::vector<std::uint8_t> a(n);
+            std::vector<std::vector<std::int8_t>> ws(4, std::vector<std::int8_t>(n));
+            for (int j = 0; j < n; ++j) {
+                a[j] = static_cast<std::uint8_t>(j % 3 == 0 ? 127 : (j * 29) % 128);
+                for (int r = 0; r < 4; ++r) ws[r][j] = static_cast<std::int8_t>(j % 5 == r ? -127 : (j * 13 + r * 7) % 255 - 127);
+            }
+            const std::int8_t* w[4] = {ws[0].data(), ws[1].data(), ws[2].data(), ws[3].data()};
+
+            ASSERT_EQ(k->dot(a.data(), w[0], n), ref->dot(a.data(), w[0], n));
+            std::int32_t out[4], outRef[4];
+            k->dot4(a.data(), w, n, out);
+            ref->dot4(a.data(), w, n, outRef);
+            for (int r = 0; r < 4; ++r) ASSERT_EQ(out[r], outRef[r]);
+
+            std::vector<std::int32_t> acc(n, 1000), accRef(n, 1000);
+            k->addColumn(w[1], acc.data(), n);
+            ref->addColumn(w[1], accRef.data(), n);
+            ASSERT_TRUE(acc == accRef);
+        }
+    }
+}
@@ -9,8 +9,8 @@ TEST(LayerInitialization) {
     // For now, let's just ensure it constructs without crashing and forward returns correct size.
     // Ideally we would add getters for testing or make the test a friend.
     
-    std::vector<double> input = {1.0, 2.0};
-    std::vector<double> output = layer.forward(input);
+    nn::Vector input = {1.0, 2.0};
+    nn::Vector output = layer.forward(input);
     
     ASSERT_EQ(output.size(), 3);
     for (double val : output) {
@@ -18,3 +18,29 @@ TEST(LayerInitialization) {
         ASSERT_TRUE(val <= 1.0);
     }
 }
+
+TEST(LayerFusedBackwardMatchesSeparatePasses) {
+    for (auto type : {nn::ActivationType::RELU, nn::ActivationType::SIGMOID}) {
+        nn::Layer separate(13, 7, type);
+        nn::Layer fused = separate;
+
+        nn::Vector input(13), grad(7);
+        for (int j = 0; j < 13; ++j) input[j] = std::sin(j * 0.7);
+        for (int i = 0; i < 7; ++i) grad[i] = std::cos(i * 1.3);
+        separate.forward(input);
+        fused.forward(input);
+
+        separate.accumulateGradients(grad);
+        nn::Vector expected = separate.backward(grad);
+        nn::Vector gradInput(13, 42.0); // Écrasé, pas accumulé
+        fused.backwardFused(grad.data(), gradInput.data());
+        for (int j = 0; j < 13; ++j) ASSERT_NEAR(gradInput[j], expected[j], 1e-5);
+
+        separate.updateWeights(0.1, 1);
+        fused.updateWeights(0.1, 1);
+        for (int i = 0; i < 7; ++i) {
+            for (int j = 0; j < 13; ++j) ASSERT_NEAR(fused.getWeights()(i, j), separate.getWeights()(i, j), 1e-6);
+            ASSERT_NEAR(fused.getBiases()[i], separate.getBiases()[i], 1e-6);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#include "unit_test.hpp"
+#include "../include/Matrix.hpp"
+#include <cstdint>
+
+TEST(MatrixLayoutTest) {
+    nn::Matrix m(3, 838, 0.5);
+
+    ASSERT_EQ(m.rows(), 3);
+    ASSERT_EQ(m.cols(), 838);
+    ASSERT_TRUE(m.stride() >= m.cols());
+    ASSERT_EQ(m.stride() % 8, 0);
+
+    // Chaque ligne commence sur une ligne de cache
+    for (int i = 0; i < m.rows(); ++i) {
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(m.row(i).data()) % nn::Matrix::ALIGNMENT, 0u);
+        ASSERT_EQ(m.row(i).size(), 838u);
+    }
+
+    m(1, 837) = 2.0;
+    ASSERT_EQ(m.row(1)[837], 2.0);
+    ASSERT_EQ(m(2, 0), 0.5);
+
+    // Le padding n'est jamais touché par fill()
+    ASSERT_EQ(m.data()[m.stride() - 1], 0.0);
+}
@@ -0,0 +1,173 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/ModelFile.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Même hachage que ModelFile.cpp : un fichier forgé peut recalculer son checksum
+std::uint64_t fnv1a(const char* data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+TEST(BinaryModelRoundTripIsExact) {
+    const std::string path = "test_model_roundtrip.nn";
+    nn::Network net = test_helpers::makeNetwork({20, 8, 3});
+    net.save(path);
+    ASSERT_TRUE(nn::model::isBinary(path));
+
+    nn::Network loaded;
+    loaded.load(path);
+    ASSERT_TRUE(test_helpers::sameWeights(net, loaded));
+    // Même type scalaire : les poids de chaque couche, première (transposée) comprise, sont lus
+    // directement dans le fichier mappé
+    ASSERT_TRUE(loaded.layer(0).hasSparseInput());
+    for (size_t l = 0; l < loaded.layerCount(); ++l) ASSERT_TRUE(loaded.layer(l).getWeights().isView());
+
+    nn::Vector input(20, 0.25);
+    auto a = net.forward(input);
+    auto b = loaded.forward(input);
+    for (size_t k = 0; k < a.size(); ++k) ASSERT_EQ(a[k], b[k]);
+    std::remove(path.c_str());
+}
+
+TEST(LegacyTextModelConverts) {
+    const std::string legacy = "test_model_legacy.nn";
+    const std::string binary = "test_model_converted.nn";
+    {
+        std::ofstream file(legacy);
+        file << "1\n2 2 1\n0.5 -1 \n2 0.25 \n0.1 -0.2 \n";
+    }
+    ASSERT_TRUE(!nn::model::isBinary(legacy));
+
+    nn::Network net;
+    net.load(legacy);
+    ASSERT_EQ(net.layerCount(), 1);
+    auto out = net.forward({1.0, 2.0});
+    ASSERT_NEAR(out[0], 0.0, 1e-6);                 // relu(0.5 - 2 + 0.1)
+    ASSERT_NEAR(out[1], 2.3, 1e-6);                 // relu(2 + 0.5 - 0.2)
+
+    net.save(binary);
+    nn::Network converted;
+    converted.load(binary);
+    ASSERT_TRUE(test_helpers::sameWeights(net, converted));
+    std::remove(legacy.c_str());
+    std::remove(binary.c_str());
+}
+
+TEST(CorruptedModelIsRejected) {
+    const std::string path = "test_model_corrupted.nn";
+    test_helpers::makeNetwork({20, 8, 3}).save(path);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(200);
+        file.put('\x7f');
+    }
+
+    bool threw = false;
+    nn::Network net;
+    try {
+        nn::model::read(path, net);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(net.layerCount(), 0);
+    std::remove(path.c_str());
+}
+
+TEST(MappedModelTrainsWithoutTouchingFile) {
+    const std::string path = "test_model_mapped.nn";
+    nn::Network original = test_helpers::makeNetwork({20, 8, 3});
+    original.save(path);
+
+    nn::Network net;
+    net.load(path);
+    nn::Matrix inputs(4, 20, 0.5), targets(4, 3);
+    for (int b = 0; b < 4; ++b) targets(b, b % 3) = 1.0;
+    nn::ParallelTrainer trainer(net, 1);
+    trainer.trainBatch(inputs, targets, 0.5);
+    ASSERT_TRUE(!test_helpers::sameWeights(original, net));
+
+    // MAP_PRIVATE : les mises à jour restent dans la mémoire du processus
+    nn::Network reloaded;
+    reloaded.load(path);
+    ASSERT_TRUE(test_helpers::sameWeights(original, reloaded));
+    std::remove(path.c_str());
+}
+
+TEST(MismatchedLayerSizesAreRejected) {
+    const std::string path = "test_model_mismatched.nn";
+    nn::Network broken;
+    broken.addLayer(20, 8, nn::ActivationType::RELU);
+    broken.addLayer(9, 3, nn::ActivationType::SOFTMAX);
+    nn::model::write(broken, path);
+
+    bool threw = false;
+    nn::Network net;
+    try {
+        nn::model::read(path, net);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(net.layerCount(), 0);
+    std::remove(path.c_str());
+}
+
+TEST(ForgedLayerOffsetsAreRejected) {
+    const std::string path = "test_model_forged.nn";
+    test_helpers::makeNetwork({20, 8, 3}).save(path);
+    std::vector<char> original;
+    {
+        std::ifstream file(path, std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // biasesOffset mal aligné, puis offsets qui débordent en 64 bits ; checksum recalculé
+    const std::size_t record = sizeof(nn::model::Header);
+    const std::size_t weights = record + offsetof(nn::model::LayerRecord, weightsOffset);
+    const std::size_t biases = record + offsetof(nn::model::LayerRecord, biasesOffset);
+    const std::pair<std::size_t, std::int64_t> forgeries[] = {{biases, 4}, {biases, -1024}, {weights, -1024}};
+    for (const auto& [field, delta] : forgeries) {
+        std::vector<char> bytes = original;
+        std::uint64_t offset;
+        std::memcpy(&offset, bytes.data() + field, sizeof(offset));
+        offset = delta < 0 ? static_cast<std::uint64_t>(delta) : offset + delta;
+        std::memcpy(bytes.data() + field, &offset, sizeof(offset));
+        const std::uint64_t checksum = fnv1a(bytes.data() + sizeof(nn::model::Header),
+                                             bytes.size() - sizeof(nn::model::Header));
+        std::memcpy(bytes.data() + offsetof(nn::model::Header, checksum), &checksum, sizeof(checksum));
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(bytes.data(), bytes.size());
+        }
+
+        bool threw = false;
+        nn::Network net;
+        try {
+            nn::model::read(path, net);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+    }
+    std::remove(path.c_str());
+}
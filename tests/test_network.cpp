@@ -6,8 +6,8 @@ TEST(NetworkTest) {
     net.addLayer(2, 3); // Input 2 -> Hidden 3
     net.addLayer(3, 1); // Hidden 3 -> Output 1
     
-    std::vector<double> input = {0.5, -0.5};
-    std::vector<double> output = net.forward(input);
+    nn::Vector input = {0.5, -0.5};
+    nn::Vector output = net.forward(input);
     
     ASSERT_EQ(output.size(), 1);
     ASSERT_TRUE(output[0] >= 0.0);
@@ -0,0 +1,240 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/Optimizer.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr double TOLERANCE = std::is_same_v<nn::Scalar, float> ? 1e-4 : 1e-9;
+
+void makeSparseBatch(nn::SparseBatch& sparse, nn::Matrix& dense, nn::Matrix& targets, int inputs = 20) {
+    sparse.clear(inputs);
+    dense.resize(12, inputs);
+    targets.resize(12, 3);
+    for (int b = 0; b < 12; ++b) {
+        std::vector<int> active;
+        for (int j = b % 5; j < inputs; j += 3 + b % 2) active.push_back(j);
+        sparse.addRow(active);
+        for (int j : active) dense(b, j) = 1;
+        targets(b, b % 3) = 1;
+    }
+}
+
+nn::OptimizerOptions options(nn::OptimizerType type) {
+    nn::OptimizerOptions o;
+    o.type = type;
+    o.weightDecay = (type == nn::OptimizerType::ADAMW) ? 0.01 : 0.0;
+    return o;
+}
+
+} // namespace
+
+TEST(OptimizerAdamMatchesReference) {
+    // Une couche 1x2 : deux pas d'Adam comparés au calcul direct avec corrections de biais
+    nn::Matrix weights(1, 2), grad(1, 2);
+    weights(0, 0) = 0.5; weights(0, 1) = -0.25;
+    std::vector<nn::Scalar> biases = {0.1}, gradBiases = {0.4};
+    auto adam = nn::Optimizer::create(options(nn::OptimizerType::ADAM));
+
+    double w = 0.5, m = 0, v = 0;
+    const double lr = 0.01, b1 = 0.9, b2 = 0.999, eps = 1e-8;
+    for (int t = 1; t <= 2; ++t) {
+        grad(0, 0) = 0.3 * t; grad(0, 1) = -0.2;
+        adam->beginStep();
+        adam->update(0, weights, biases, grad, gradBiases, nn::Scalar(0.5), lr);
+
+        const double g = 0.3 * t * 0.5;
+        m = b1 * m + (1 - b1) * g;
+        v = b2 * v + (1 - b2) * g * g;
+        w -= lr * (m / (1 - std::pow(b1, t))) / (std::sqrt(v / (1 - std::pow(b2, t))) + eps);
+        ASSERT_NEAR(weights(0, 0), w, 1e-6);
+    }
+    ASSERT_EQ(adam->steps(), 2);
+}
+
+TEST(OptimizerMomentumAndNesterov) {
+    for (auto type : {nn::OptimizerType::MOMENTUM, nn::OptimizerType::NESTEROV}) {
+        nn::Matrix weights(1, 1), grad(1, 1);
+        std::vector<nn::Scalar> biases = {0}, gradBiases = {0};
+        auto opt = nn::Optimizer::create(options(type));
+        double w = 0, velocity = 0;
+        for (int t = 0; t < 3; ++t) {
+            grad(0, 0) = 1.0;
+            opt->beginStep();
+            opt->update(0, weights, biases, grad, gradBiases, 1, 0.1);
+            velocity = 0.9 * velocity + 1.0;
+            w -= 0.1 * (type == nn::OptimizerType::NESTEROV ? 1.0 + 0.9 * velocity : velocity);
+            ASSERT_NEAR(weights(0, 0), w, 1e-6);
+        }
+    }
+}
+
+TEST(OptimizersReduceLoss) {
+    nn::SparseBatch sparse;
+    nn::Matrix dense, targets;
+    makeSparseBatch(sparse, dense, targets);
+
+    for (auto type : {nn::OptimizerType::SGD, nn::OptimizerType::MOMENTUM, nn::OptimizerType::NESTEROV,
+                      nn::OptimizerType::ADAM, nn::OptimizerType::ADAMW}) {
+        nn::Network net = test_helpers::makeNetwork({20, 8, 3});
+        auto opt = nn::Optimizer::create(options(type));
+        nn::ParallelTrainer trainer(net, 1, opt.get());
+        const double lr = (type == nn::OptimizerType::ADAM || type == nn::OptimizerType::ADAMW) ? 0.01 : 0.1;
+        const double first = trainer.trainBatch(sparse, targets, lr).loss;
+        double last = first;
+        for (int step = 0; step < 50; ++step) last = trainer.trainBatch(sparse, targets, lr).loss;
+        ASSERT_TRUE(last < first);
+    }
+}
+
+TEST(OptimizerSparseMatchesDense) {
+    // Première couche en [input][output] : gradient creux et dense dans la même disposition
+    nn::SparseBatch sparse;
+    nn::Matrix dense, targets;
+    makeSparseBatch(sparse, dense, targets);
+
+    nn::Network a = test_helpers::makeNetwork({20, 8, 3});
+    nn::Network b = a;
+    auto optA = nn::Optimizer::create(options(nn::OptimizerType::ADAMW));
+    auto optB = nn::Optimizer::create(options(nn::OptimizerType::ADAMW));
+    nn::ParallelTrainer ta(a, 1, optA.get()), tb(b, 2, optB.get());
+    for (int step = 0; step < 5; ++step) {
+        ta.trainBatch(sparse, targets, 0.01);
+        tb.trainBatch(dense, targets, 0.01);
+    }
+    nn::Matrix outA = a.forwardBatch(dense), outB = b.forwardBatch(dense);
+    for (int r = 0; r < outA.rows(); ++r) {
+        for (int k = 0; k < 3; ++k) ASSERT_NEAR(outA(r, k), outB(r, k), TOLERANCE);
+    }
+}
+
+TEST(OptimizerStateRoundTrip) {
+    nn::SparseBatch sparse;
+    nn::Matrix dense, targets;
+    makeSparseBatch(sparse, dense, targets);
+    const std::string path = "/tmp/mytorch_test_optimizer.opt";
+
+    nn::Network net = test_helpers::makeNetwork({20, 8, 3});
+    auto opt = nn::Optimizer::create(options(nn::OptimizerType::ADAM));
+    {
+        nn::ParallelTrainer trainer(net, 1, opt.get());
+        for (int step = 0; step < 3; ++step) trainer.trainBatch(sparse, targets, 0.01);
+    }
+    opt->save(path);
+
+    // Reprise : même état, même suite de mises à jour
+    nn::Network resumed = net;
+    auto restored = nn::Optimizer::create(options(nn::OptimizerType::ADAM));
+    restored->load(path);
+    ASSERT_EQ(restored->steps(), 3);
+    nn::ParallelTrainer t1(net, 1, opt.get()), t2(resumed, 1, restored.get());
+    t1.trainBatch(sparse, targets, 0.01);
+    t2.trainBatch(sparse, targets, 0.01);
+    nn::Matrix out1 = net.forwardBatch(dense), out2 = resumed.forwardBatch(dense);
+    for (int r = 0; r < out1.rows(); ++r) {
+        for (int k = 0; k < 3; ++k) ASSERT_EQ(out1(r, k), out2(r, k));
+    }
+
+    // Type différent : refusé
+    auto other = nn::Optimizer::create(options(nn::OptimizerType::MOMENTUM));
+    bool threw = false;
+    try {
+        other->load(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    std::remove(path.c_str());
+
+    threw = false;
+    try {
+        nn::Optimizer::parseType("rmsprop");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
+
+TEST(OptimizerStateRoundTripSparseFirstLayer) {
+    // Première couche en [input][output] : 40 lignes de poids pour 4 biais seulement
+    nn::SparseBatch sparse;
+    nn::Matrix dense, targets;
+    makeSparseBatch(sparse, dense, targets, 40);
+    const std::string path = "/tmp/mytorch_test_optimizer_sparse.opt";
+
+    nn::Network net = test_helpers::makeNetwork({40, 4, 3});
+    auto opt = nn::Optimizer::create(options(nn::OptimizerType::ADAMW));
+    {
+        nn::ParallelTrainer trainer(net, 1, opt.get());
+        for (int step = 0; step < 3; ++step) trainer.trainBatch(sparse, targets, 0.01);
+    }
+    opt->save(path);
+
+    nn::Network resumed = net;
+    auto restored = nn::Optimizer::create(options(nn::OptimizerType::ADAMW));
+    restored->load(path);
+    nn::ParallelTrainer t1(net, 1, opt.get()), t2(resumed, 1, restored.get());
+    t1.trainBatch(sparse, targets, 0.01);
+    t2.trainBatch(sparse, targets, 0.01);
+    nn::Matrix out1 = net.forwardBatch(dense), out2 = resumed.forwardBatch(dense);
+    for (int r = 0; r < out1.rows(); ++r) {
+        for (int k = 0; k < 3; ++k) ASSERT_EQ(out1(r, k), out2(r, k));
+    }
+
+    // Même forme de poids, autre nombre de biais : refusé à la première mise à jour
+    nn::Matrix weights(40, 4), grad(40, 4);
+    std::vector<nn::Scalar> biases(5), gradBiases(5);
+    auto mismatched = nn::Optimizer::create(options(nn::OptimizerType::ADAMW));
+    mismatched->load(path);
+    mismatched->beginStep();
+    bool threw = false;
+    try {
+        mismatched->update(0, weights, biases, grad, gradBiases, 1, 0.01);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    std::remove(path.c_str());
+}
+
+TEST(WeightDecayAppliesToEveryOptimizer) {
+    // Gradient nul : seul le terme L2 déplace les poids, jamais les biais
+    const double lr = 0.1, decay = 0.1;
+    const std::pair<nn::OptimizerType, double> expected[] = {
+        {nn::OptimizerType::SGD, 1 - lr * decay},
+        {nn::OptimizerType::MOMENTUM, 1 - lr * decay},
+        {nn::OptimizerType::NESTEROV, 1 - lr * (decay + 0.9 * decay)},
+    };
+    for (const auto& [type, w] : expected) {
+        nn::Matrix weights(1, 1, 1.0), grad(1, 1);
+        std::vector<nn::Scalar> biases = {1}, gradBiases = {0};
+        nn::OptimizerOptions o = options(type);
+        o.weightDecay = decay;
+        auto opt = nn::Optimizer::create(o);
+        opt->beginStep();
+        opt->update(0, weights, biases, grad, gradBiases, 1, lr);
+        ASSERT_NEAR(weights(0, 0), w, 1e-6);
+        ASSERT_EQ(biases[0], 1);
+    }
+
+    // Par le réseau : SGD avec weight_decay ne prend pas la mise à jour en place sans régularisation
+    nn::SparseBatch sparse;
+    nn::Matrix dense, targets;
+    makeSparseBatch(sparse, dense, targets);
+    nn::Network plain = test_helpers::makeNetwork({20, 8, 3});
+    nn::Network decayed = plain;
+    const nn::Scalar before = plain.layer(1).weight(0, 0);
+    nn::OptimizerOptions o = options(nn::OptimizerType::SGD);
+    auto sgd = nn::Optimizer::create(o);
+    o.weightDecay = decay;
+    auto sgdDecay = nn::Optimizer::create(o);
+    nn::ParallelTrainer(plain, 1, sgd.get()).trainBatch(sparse, targets, lr);
+    nn::ParallelTrainer(decayed, 1, sgdDecay.get()).trainBatch(sparse, targets, lr);
+    ASSERT_NEAR(decayed.layer(1).weight(0, 0), plain.layer(1).weight(0, 0) - lr * decay * before, TOLERANCE);
+}
@@ -0,0 +1,71 @@
+#include "unit_test.hpp"
+#include "../include/PackedDataset.hpp"
+#include "../include/Dataset.hpp"
+#include "../include/FENParser.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const char* const FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3",
+    "4k3/8/8/3pP3/8/8/8/4K2R w K d6 0 1",
+    "r3k2r/8/8/8/8/8/8/R3K2R b qkQK - 0 1",
+};
+
+} // namespace
+
+TEST(PackedBoardRoundTripMatchesParser) {
+    for (const char* fen : FENS) {
+        std::vector<int> expected, decoded;
+        analyzer::FENParser::fenToIndices(fen, expected);
+        analyzer::PackedBoard board = analyzer::PackedDataset::encode(expected, 2);
+        analyzer::PackedDataset::decode(board, decoded);
+        ASSERT_TRUE(decoded == expected);
+        ASSERT_EQ((int)board.label, 2);
+    }
+}
+
+TEST(PackedDatasetMatchesTextDataset) {
+    const std::string text = "test_packed_dataset.txt";
+    const std::string packed = "test_packed_dataset.mtds";
+    {
+        std::ofstream file(text);
+        file << FENS[0] << ";Nothing\n" << FENS[1] << ";Checkmate\n";
+        file << "invalid line\n";
+        file << FENS[2] << ";Check\n";
+    }
+
+    ASSERT_EQ(analyzer::PackedDataset::pack(text, packed), (size_t)3);
+    ASSERT_TRUE(analyzer::PackedDataset::isPacked(packed));
+    ASSERT_TRUE(!analyzer::PackedDataset::isPacked(text));
+
+    auto reference = analyzer::Dataset::loadSparse(text);
+    analyzer::PackedDataset data(packed);
+    ASSERT_EQ(data.size(), reference.size());
+    ASSERT_EQ(data.classCount(), 3);
+    for (size_t i = 0; i < data.size(); ++i) {
+        std::vector<int> indices;
+        data.indices(i, indices);
+        ASSERT_TRUE(indices == reference[i].indices);
+        ASSERT_EQ(reference[i].target[data.label(i)], 1.0);
+    }
+
+    // Fichier tronqué : refusé au chargement
+    {
+        std::ofstream file(packed, std::ios::binary | std::ios::app);
+        file << 'x';
+    }
+    bool threw = false;
+    try {
+        analyzer::PackedDataset broken(packed);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    std::remove(text.c_str());
+    std::remove(packed.c_str());
+}
@@ -0,0 +1,57 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include <vector>
+#include <type_traits>
+
+namespace {
+
+constexpr double TOLERANCE = std::is_same_v<nn::Scalar, float> ? 1e-4 : 1e-9;
+
+} // namespace
+
+TEST(ParallelTrainerMatchesSingleThread) {
+    nn::Matrix inputs, targets;
+    test_helpers::makeBatch(inputs, targets, 10, 12);
+
+    nn::Network single = test_helpers::makeNetwork({12, 8, 3}, nn::ActivationType::SIGMOID);
+    nn::Network threaded = single;
+    nn::Network threadedAgain = single;
+
+    nn::ParallelTrainer t1(single, 1);
+    nn::ParallelTrainer t3(threaded, 3);
+    nn::ParallelTrainer t3Again(threadedAgain, 3);
+    for (int step = 0; step < 5; ++step) {
+        auto a = t1.trainBatch(inputs, targets, 0.1);
+        auto b = t3.trainBatch(inputs, targets, 0.1);
+        t3Again.trainBatch(inputs, targets, 0.1);
+        ASSERT_NEAR(a.loss, b.loss, TOLERANCE);
+        ASSERT_EQ(a.correct, b.correct);
+    }
+
+    nn::Matrix out1 = single.forwardBatch(inputs);
+    nn::Matrix out3 = threaded.forwardBatch(inputs);
+    nn::Matrix out3Again = threadedAgain.forwardBatch(inputs);
+    for (int b = 0; b < inputs.rows(); ++b) {
+        for (int k = 0; k < 3; ++k) {
+            ASSERT_NEAR(out1(b, k), out3(b, k), TOLERANCE);
+            // Même nombre de threads : résultat bit à bit identique
+            ASSERT_EQ(out3(b, k), out3Again(b, k));
+        }
+    }
+}
+
+TEST(ThreadPoolRunsEveryTask) {
+    nn::ThreadPool pool(4);
+    std::vector<int> hits(100, 0);
+    pool.parallelFor(100, [&](int i) { hits[i]++; });
+    for (int h : hits) ASSERT_EQ(h, 1);
+
+    bool thrown = false;
+    try {
+        pool.parallelFor(8, [](int i) { if (i == 5) throw std::runtime_error("boom"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+}
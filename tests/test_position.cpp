@@ -0,0 +1,152 @@
+#include "unit_test.hpp"
+#include "../include/FeatureExtractor.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Position.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    "8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59",
+    "rnbqkbnr/pp1ppppp/8/2pP4/8/8/PPP1PPPP/RNBQKBNR w Kq c6 0 2",
+    "8/8/8/8/8/8/8/8 b - - 0 1",
+};
+
+int square(const char* name) { return ('8' - name[1]) * 8 + (name[0] - 'a'); }
+
+} // namespace
+
+TEST(PositionFenRoundTrip) {
+    for (const char* fen : FENS) {
+        analyzer::Position position;
+        ASSERT_TRUE(analyzer::Position::fromFen(fen, position));
+        ASSERT_TRUE(position.toFen() == fen);
+    }
+    // Annotation après les compteurs ignorée, comme FENParser
+    analyzer::Position annotated;
+    ASSERT_TRUE(analyzer::Position::fromFen(std::string(FENS[2]) + " Check", annotated));
+    ASSERT_TRUE(annotated.toFen() == FENS[2]);
+}
+
+TEST(PositionRejectsWhatFENParserRejects) {
+    const char* invalid[] = {
+        "",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/rnbqkbnr w KQkq - 0 1",
+        "rnbqkbnr/pppppppp/44p/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkk - 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e5 0 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - x 1",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1234567890",
+    };
+    int indices[analyzer::FeatureExtractor::MAX_ACTIVE];
+    for (const char* fen : invalid) {
+        analyzer::Position position;
+        ASSERT_TRUE(!analyzer::Position::fromFen(fen, position));
+        ASSERT_EQ(analyzer::FeatureExtractor(analyzer::FeatureExtractor::ALL).extract(std::string_view(fen), indices), -1);
+        ASSERT_EQ(analyzer::FENParser::toIndices(fen, indices), -1);
+    }
+}
+
+TEST(FeatureExtractorMatchesFENParser) {
+    const analyzer::FeatureExtractor extractor;
+    ASSERT_EQ(extractor.featureCount(), analyzer::FENParser::FEATURE_COUNT);
+    for (const char* fen : FENS) {
+        std::vector<int> expected;
+        ASSERT_TRUE(analyzer::FENParser::fenToIndices(fen, expected));
+
+        analyzer::Position position;
+        ASSERT_TRUE(analyzer::Position::fromFen(fen, position));
+        int indices[analyzer::FeatureExtractor::MAX_ACTIVE];
+        const int count = extractor.extract(position, indices);
+        ASSERT_TRUE(std::vector<int>(indices, indices + count) == expected);
+
+        // Retour depuis les features : même position au sens de key()
+        analyzer::Position rebuilt;
+        ASSERT_TRUE(analyzer::Position::fromFeatures(expected, rebuilt));
+        ASSERT_EQ(extractor.extract(rebuilt, indices), count);
+        ASSERT_TRUE(std::vector<int>(indices, indices + count) == expected);
+    }
+}
+
+TEST(PositionKeyIgnoresCounters) {
+    analyzer::Position a, b, c;
+    ASSERT_TRUE(analyzer::Position::fromFen("8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59", a));
+    ASSERT_TRUE(analyzer::Position::fromFen("8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 0 1", b));
+    ASSERT_TRUE(analyzer::Position::fromFen("8/8/R2k4/4r1p1/8/5K2/5P2/8 w - - 7 59", c));
+    ASSERT_TRUE(a == b);
+    ASSERT_EQ(a.key(), b.key());
+    ASSERT_TRUE(!(a == c));
+    ASSERT_TRUE(a.key() != c.key());
+}
+
+TEST(FeatureExtractorOptionalSets) {
+    analyzer::Position position;
+    ASSERT_TRUE(analyzer::Position::fromFen("8/8/R2k4/4r1p1/8/5K2/5P2/8 b - - 7 59", position));
+
+    // Tour blanche a6 : colonne a et rangée 6 jusqu'au roi noir d6 inclus
+    const std::uint64_t white = analyzer::FeatureExtractor::attacks(position, true);
+    ASSERT_TRUE(white & (1ull << square("a1")));
+    ASSERT_TRUE(white & (1ull << square("d6")));
+    ASSERT_TRUE(!(white & (1ull << square("e6"))));
+    // Pion blanc f2 : e3 et g3 ; roi blanc f3 : e4
+    ASSERT_TRUE(white & (1ull << square("e3")));
+    ASSERT_TRUE(white & (1ull << square("g3")));
+    ASSERT_TRUE(white & (1ull << square("e4")));
+    // Pion noir g5 : f4 et h4 ; tour noire e5 : colonne e libre jusqu'à e1
+    const std::uint64_t black = analyzer::FeatureExtractor::attacks(position, false);
+    ASSERT_TRUE(black & (1ull << square("f4")));
+    ASSERT_TRUE(black & (1ull << square("h4")));
+    ASSERT_TRUE(black & (1ull << square("e1")));
+    ASSERT_TRUE(black & (1ull << square("g5")));      // Défend son pion
+    ASSERT_TRUE(!(black & (1ull << square("h5"))));   // Masqué par le pion g5
+
+    const analyzer::FeatureExtractor all(analyzer::FeatureExtractor::ALL);
+    ASSERT_EQ(all.featureCount(), 838 + 128 + 36 + 90);
+    int indices[analyzer::FeatureExtractor::MAX_ACTIVE];
+    const int count = all.extract(position, indices);
+    ASSERT_EQ(count, 64 + std::popcount(white) + std::popcount(black) + 4 + 10);
+    ASSERT_TRUE(std::is_sorted(indices, indices + count));
+    ASSERT_TRUE(indices[count - 1] < all.featureCount());
+
+    // Nombre de pions blancs (1) puis de cavaliers blancs (0) dans le dernier bloc
+    const int counts = all.featureCount() - analyzer::FeatureExtractor::PIECE_COUNT_FEATURES;
+    ASSERT_TRUE(std::find(indices, indices + count, counts + 1) != indices + count);
+    ASSERT_TRUE(std::find(indices, indices + count, counts + 9) != indices + count);
+    // Roi noir d6 : une pièce amie voisine (tour e5), aucune pièce blanche
+    const int zone = 838 + 128 + 18;
+    ASSERT_TRUE(std::find(indices, indices + count, zone + 1) != indices + count);
+    ASSERT_TRUE(std::find(indices, indices + count, zone + 9) != indices + count);
+}
+
+TEST(FeatureExtractorSelection) {
+    const auto extractor = analyzer::FeatureExtractor::parse("attacks, piece_counts");
+    ASSERT_EQ(extractor.sets(), analyzer::FeatureExtractor::ATTACKS | analyzer::FeatureExtractor::PIECE_COUNTS);
+    ASSERT_TRUE(extractor.name() == "base,attacks,piece_counts");
+    ASSERT_EQ(analyzer::FeatureExtractor::parse("base").sets(), analyzer::FeatureExtractor::BASE);
+
+    bool threw = false;
+    try {
+        analyzer::FeatureExtractor::parse("mobility");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // Chaque combinaison a une taille distincte : la taille d'entrée d'un modèle suffit
+    for (unsigned sets = 0; sets <= analyzer::FeatureExtractor::ALL; ++sets) {
+        analyzer::FeatureExtractor found;
+        ASSERT_TRUE(analyzer::FeatureExtractor::forInputSize(analyzer::FeatureExtractor(sets).featureCount(), found));
+        ASSERT_EQ(found.sets(), sets);
+    }
+    analyzer::FeatureExtractor none;
+    ASSERT_TRUE(!analyzer::FeatureExtractor::forInputSize(100, none));
+}
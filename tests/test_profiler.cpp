@@ -0,0 +1,31 @@
+#include "unit_test.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+
+TEST(ProfilerTimesEachLayerOnlyWhenEnabled) {
+    nn::Network net;
+    net.addLayer(10, 6, nn::ActivationType::RELU);
+    net.addLayer(6, 3, nn::ActivationType::SOFTMAX);
+    nn::Matrix inputs(8, 10, 0.5), targets(8, 3);
+    for (int b = 0; b < 8; ++b) targets(b, b % 3) = 1;
+    nn::ParallelTrainer trainer(net, 2);
+
+    nn::profile::reset();
+    trainer.trainBatch(inputs, targets, 0.01);
+    for (size_t l = 0; l < 2; ++l) ASSERT_TRUE(nn::profile::seconds(nn::profile::FORWARD, l) == 0.0);
+
+    nn::profile::setEnabled(true);
+    trainer.trainBatch(inputs, targets, 0.01);
+    nn::profile::setEnabled(false);
+    if (nn::profile::AVAILABLE) {
+        for (size_t l = 0; l < 2; ++l) {
+            ASSERT_TRUE(nn::profile::seconds(nn::profile::FORWARD, l) > 0.0);
+            ASSERT_TRUE(nn::profile::seconds(nn::profile::BACKWARD, l) > 0.0);
+            ASSERT_TRUE(nn::profile::seconds(nn::profile::UPDATE, l) > 0.0);
+        }
+        ASSERT_TRUE(nn::profile::seconds(nn::profile::FORWARD, 2) == 0.0);
+    }
+    ASSERT_TRUE(nn::profile::peakRssBytes() > 0);
+    nn::profile::reset();
+}
@@ -0,0 +1,121 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/QuantizedNetwork.hpp"
+#include "../include/Network.hpp"
+#include "../include/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+nn::Network makeNetwork() {
+    nn::Utils::seed(21);
+    return test_helpers::makeNetwork({200, 48, 16, 3});
+}
+
+// Entrées binaires creuses : une vingtaine de features actives sur 200, comme une position
+nn::SparseBatch makeInputs(int rows, unsigned seed) {
+    std::mt19937 rng(seed);
+    nn::SparseBatch batch(200);
+    std::vector<int> active;
+    for (int r = 0; r < rows; ++r) {
+        active.clear();
+        for (int j = 0; j < 200; ++j) {
+            if (rng() % 10 == 0) active.push_back(j);
+        }
+        batch.addRow(active);
+    }
+    return batch;
+}
+
+int argmax(std::span<const nn::Scalar> values) {
+    return static_cast<int>(std::max_element(values.begin(), values.end()) - values.begin());
+}
+
+} // namespace
+
+TEST(QuantizedMatchesFloat) {
+    nn::Network net = makeNetwork();
+    const nn::SparseBatch calibration = makeInputs(500, 1);
+    const nn::SparseBatch inputs = makeInputs(500, 2);
+
+    for (auto granularity : {nn::QuantizedNetwork::Granularity::CHANNEL, nn::QuantizedNetwork::Granularity::LAYER}) {
+        nn::QuantizedNetwork q = nn::QuantizedNetwork::quantize(net, calibration, granularity);
+        ASSERT_EQ(q.inputSize(), 200);
+        ASSERT_EQ(q.outputSize(), 3);
+        // Au moins 2x plus petit que des poids float32, malgré les lignes paddées à 64 octets
+        ASSERT_TRUE(q.parameterBytes() * 2 < (200 * 48 + 48 * 16 + 16 * 3) * sizeof(float));
+
+        int agree = 0;
+        double worst = 0;
+        for (int r = 0; r < inputs.rows(); ++r) {
+            auto expected = net.infer(inputs.row(r));
+            const int expectedClass = argmax(expected);
+            std::vector<nn::Scalar> reference(expected.begin(), expected.end());
+            auto probs = q.infer(inputs.row(r));
+            ASSERT_EQ(probs.size(), reference.size());
+            for (size_t k = 0; k < probs.size(); ++k) worst = std::max(worst, std::abs(double(probs[k] - reference[k])));
+            agree += argmax(probs) == expectedClass;
+        }
+        ASSERT_TRUE(worst < 0.05);
+        ASSERT_TRUE(agree >= inputs.rows() * 95 / 100);
+    }
+}
+
+TEST(QuantizedSaveLoadRoundTrip) {
+    nn::Network net = makeNetwork();
+    nn::QuantizedNetwork q = nn::QuantizedNetwork::quantize(net, makeInputs(100, 3), nn::QuantizedNetwork::Granularity::CHANNEL);
+    const std::string path = "test_quantized.qnn";
+    q.save(path);
+    ASSERT_TRUE(nn::QuantizedNetwork::isQuantized(path));
+
+    nn::QuantizedNetwork loaded;
+    loaded.load(path);
+    ASSERT_EQ(loaded.layerCount(), q.layerCount());
+    ASSERT_TRUE(loaded.granularity() == nn::QuantizedNetwork::Granularity::CHANNEL);
+    const nn::SparseBatch inputs = makeInputs(50, 4);
+    for (int r = 0; r < inputs.rows(); ++r) {
+        auto a = q.infer(inputs.row(r));
+        std::vector<nn::Scalar> expected(a.begin(), a.end());
+        auto b = loaded.infer(inputs.row(r));
+        ASSERT_TRUE(std::equal(b.begin(), b.end(), expected.begin(), expected.end()));
+    }
+
+    // Fichier tronqué : erreur, le modèle chargé reste intact
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size() / 2);
+    }
+    bool threw = false;
+    try {
+        loaded.load(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(loaded.layerCount(), q.layerCount());
+    std::remove(path.c_str());
+}
+
+TEST(QuantizedRejectsOutOfRangeIndices) {
+    nn::Network net = makeNetwork();
+    nn::QuantizedNetwork q = nn::QuantizedNetwork::quantize(net, makeInputs(50, 5), nn::QuantizedNetwork::Granularity::LAYER);
+    for (int index : {200, -1}) {
+        const int active[] = {3, index};
+        bool threw = false;
+        try {
+            q.infer(active);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        ASSERT_TRUE(threw);
+    }
+}
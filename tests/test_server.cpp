@@ -0,0 +1,196 @@
+#include "unit_test.hpp"
+#include "../include/Server.hpp"
+#include "../include/FENParser.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3",
+    "4k3/8/8/8/8/8/8/4K2R w K - 0 1",
+};
+
+bool exchange(int fd, const std::string& request, std::string& reply) {
+    if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size()) return false;
+    reply.clear();
+    char c;
+    while (::recv(fd, &c, 1, 0) == 1) {
+        if (c == '\n') return true;
+        reply += c;
+    }
+    return false;
+}
+
+void setReceiveTimeout(int fd, int seconds) {
+    timeval timeout = {seconds, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+} // namespace
+
+TEST(ServerBatchesMatchDirectForward) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 16, nn::ActivationType::RELU);
+    net.addLayer(16, 3, nn::ActivationType::SOFTMAX);
+
+    analyzer::Server::Options options;
+    options.socketPath = "test_server_" + std::to_string(::getpid()) + ".sock";
+    options.maxBatch = 4;
+    options.maxWaitMicros = 2000;
+
+    analyzer::Server server(net, options);
+    std::thread serving([&] { server.run(); });
+    for (int i = 0; i < 1000 && !server.isListening(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(server.isListening());
+
+    // Plusieurs clients concurrents : leurs requêtes se retrouvent dans les mêmes batches
+    const int clients = 3;
+    std::vector<std::vector<std::string>> replies(clients);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            int fd = analyzer::Server::connectTo(options);
+            if (fd < 0) return;
+            for (int r = 0; r < 6; ++r) {
+                std::string reply;
+                if (!exchange(fd, std::string(FENS[(c + r) % 3]) + "\n", reply)) break;
+                replies[c].push_back(reply);
+            }
+            ::close(fd);
+        });
+    }
+    for (auto& t : threads) t.join();
+    server.stop();
+    serving.join();
+
+    // Référence : forward direct, probabilités relues avec la même précision que le protocole
+    for (int c = 0; c < clients; ++c) {
+        ASSERT_EQ(replies[c].size(), (size_t)6);
+        for (int r = 0; r < 6; ++r) {
+            std::vector<int> indices;
+            analyzer::FENParser::fenToIndices(FENS[(c + r) % 3], indices);
+            nn::SparseBatch batch;
+            batch.clear(analyzer::FENParser::FEATURE_COUNT);
+            batch.addRow(indices);
+            nn::Matrix expected = net.forwardBatch(batch);
+
+            std::stringstream ss(replies[c][r]);
+            std::string label, field;
+            std::getline(ss, label, ',');
+            ASSERT_TRUE(label == "Nothing" || label == "Check" || label == "Checkmate");
+            for (int k = 0; k < 3; ++k) {
+                ASSERT_TRUE((bool)std::getline(ss, field, ','));
+                ASSERT_NEAR(std::atof(field.c_str()), (double)expected(0, k), 1e-5);
+            }
+        }
+    }
+    ASSERT_TRUE(::access(options.socketPath.c_str(), F_OK) != 0);
+}
+
+TEST(ServerSlowClientDoesNotStallOthers) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 16, nn::ActivationType::RELU);
+    net.addLayer(16, 3, nn::ActivationType::SOFTMAX);
+
+    analyzer::Server::Options options;
+    options.socketPath = "test_server_slow_" + std::to_string(::getpid()) + ".sock";
+    analyzer::Server server(net, options);
+    std::thread serving([&] { server.run(); });
+    for (int i = 0; i < 1000 && !server.isListening(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(server.isListening());
+
+    // Client qui envoie sans jamais lire : ses réponses remplissent les tampons du socket
+    int slow = analyzer::Server::connectTo(options);
+    ASSERT_TRUE(slow >= 0);
+    std::thread writer([&] {
+        const std::string line = std::string(FENS[0]) + "\n";
+        for (int i = 0; i < 50000; ++i) {
+            if (::send(slow, line.data(), line.size(), MSG_NOSIGNAL) <= 0) break;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    int fast = analyzer::Server::connectTo(options);
+    ASSERT_TRUE(fast >= 0);
+    setReceiveTimeout(fast, 5);
+    std::string reply;
+    const bool answered = exchange(fast, std::string(FENS[1]) + "\n", reply);
+    ::close(fast);
+
+    // Une ligne sans fin au-delà de la limite coupe la connexion
+    int flood = analyzer::Server::connectTo(options);
+    ASSERT_TRUE(flood >= 0);
+    setReceiveTimeout(flood, 5);
+    const std::string garbage(3 * analyzer::Server::MAX_LINE_BYTES, 'a');
+    ::send(flood, garbage.data(), garbage.size(), MSG_NOSIGNAL);
+    char c;
+    const ssize_t afterFlood = ::recv(flood, &c, 1, 0);
+    const bool dropped = afterFlood == 0 || (afterFlood < 0 && errno == ECONNRESET);   // Pas d'expiration
+    ::close(flood);
+
+    ::shutdown(slow, SHUT_RDWR);
+    writer.join();
+    ::close(slow);
+    server.stop();
+    serving.join();
+
+    ASSERT_TRUE(answered);
+    ASSERT_TRUE(reply.rfind("Nothing,", 0) == 0 || reply.rfind("Check", 0) == 0);
+    ASSERT_TRUE(dropped);
+}
+
+TEST(ServerServesQuantizedModel) {
+    nn::Network net;
+    net.addLayer(analyzer::FENParser::FEATURE_COUNT, 16, nn::ActivationType::RELU);
+    net.addLayer(16, 3, nn::ActivationType::SOFTMAX);
+    nn::SparseBatch calibration(analyzer::FENParser::FEATURE_COUNT);
+    std::vector<int> indices;
+    for (const char* fen : FENS) {
+        indices.clear();                       // fenToIndices ajoute à la fin
+        analyzer::FENParser::fenToIndices(fen, indices);
+        calibration.addRow(indices);
+    }
+    nn::QuantizedNetwork quantized = nn::QuantizedNetwork::quantize(net, calibration, nn::QuantizedNetwork::Granularity::CHANNEL);
+
+    analyzer::Server::Options options;
+    options.socketPath = "test_server_q_" + std::to_string(::getpid()) + ".sock";
+    analyzer::Server server(quantized, options);
+    std::thread serving([&] { server.run(); });
+    for (int i = 0; i < 1000 && !server.isListening(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(server.isListening());
+
+    std::vector<std::string> replies;
+    int fd = analyzer::Server::connectTo(options);
+    setReceiveTimeout(fd, 5);
+    for (const char* fen : {FENS[0], "not a fen", FENS[1], FENS[2]}) {
+        std::string reply;
+        if (!exchange(fd, std::string(fen) + "\n", reply)) break;
+        replies.push_back(reply);
+    }
+    ::close(fd);
+    server.stop();
+    serving.join();
+
+    // Le serveur ne touche plus au modèle : il peut servir de référence
+    ASSERT_EQ(replies.size(), (size_t)4);
+    ASSERT_TRUE(replies[1] == "Invalid");
+    for (int r = 0; r < 3; ++r) {
+        std::stringstream ss(replies[r == 0 ? 0 : r + 1]);
+        std::string field;
+        std::getline(ss, field, ',');
+        auto expected = quantized.infer(calibration.row(r));
+        for (int k = 0; k < 3; ++k) {
+            ASSERT_TRUE((bool)std::getline(ss, field, ','));
+            ASSERT_NEAR(std::atof(field.c_str()), (double)expected[k], 1e-5);
+        }
+    }
+}
@@ -8,7 +8,7 @@
 void test_softmax_basic() {
     std::cout << "=== Test 1: Softmax Basic ===\n";
 
-    std::vector<double> input = {1.0, 2.0, 3.0};
+    nn::Vector input = {1.0, 2.0, 3.0};
     auto output = nn::Activations::softmax(input);
 
     std::cout << "Input:  [" << input[0] << ", " << input[1] << ", " << input[2] << "]\n";
@@ -34,7 +34,7 @@ void test_network_with_softmax() {
     net.addLayer(32, 16, nn::ActivationType::RELU);
     net.addLayer(16, 3, nn::ActivationType::SOFTMAX);  // 3 classes
 
-    std::vector<double> input(64, 0.5);
+    nn::Vector input(64, 0.5);
     auto output = net.forward(input);
 
     std::cout << "Output: [" << std::fixed << std::setprecision(4)
@@ -57,8 +57,8 @@ void test_backward_with_softmax() {
     net.addLayer(4, 8, nn::ActivationType::RELU);
     net.addLayer(8, 3, nn::ActivationType::SOFTMAX);
 
-    std::vector<double> input = {0.5, 0.3, 0.8, 0.2};
-    std::vector<double> target = {0, 1, 0};  // Class 1 (Check)
+    nn::Vector input = {0.5, 0.3, 0.8, 0.2};
+    nn::Vector target = {0, 1, 0};  // Class 1 (Check)
 
     // Forward
     auto output = net.forward(input);
@@ -0,0 +1,135 @@
+#include "unit_test.hpp"
+#include "test_helpers.hpp"
+#include "../include/FENParser.hpp"
+#include "../include/Network.hpp"
+#include "../include/ParallelTrainer.hpp"
+#include "../include/SparseBatch.hpp"
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr double TOLERANCE = std::is_same_v<nn::Scalar, float> ? 1e-5 : 1e-12;
+
+const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "8/8/8/8/8/8/8/8 b - - 0 1",
+    "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1",
+    "r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1",
+};
+
+nn::SparseBatch makeSparse() {
+    nn::SparseBatch batch(analyzer::FENParser::FEATURE_COUNT);
+    for (const auto& fen : FENS) {
+        std::vector<int> indices;
+        analyzer::FENParser::fenToIndices(fen, indices);
+        batch.addRow(indices);
+    }
+    return batch;
+}
+
+} // namespace
+
+TEST(FenIndicesMatchDenseEncoding) {
+    for (const auto& fen : FENS) {
+        std::vector<int> indices;
+        analyzer::FENParser::fenToIndices(fen, indices);
+        nn::Vector dense = analyzer::FENParser::fenToVector(fen);
+
+        ASSERT_EQ(dense.size(), (size_t)analyzer::FENParser::FEATURE_COUNT);
+        size_t ones = 0;
+        for (nn::Scalar v : dense) ones += (v == 1.0);
+        ASSERT_EQ(indices.size(), ones);
+        for (size_t k = 0; k < indices.size(); ++k) {
+            ASSERT_EQ(dense[indices[k]], 1.0);
+            if (k > 0) ASSERT_TRUE(indices[k] > indices[k - 1]);
+        }
+    }
+}
+
+TEST(SparseBatchDenseRoundTrip) {
+    nn::SparseBatch sparse = makeSparse();
+    nn::Matrix dense = sparse.toDense();
+    nn::SparseBatch back = nn::SparseBatch::fromDense(dense);
+
+    ASSERT_EQ(back.rows(), sparse.rows());
+    ASSERT_EQ(back.nonZeros(), sparse.nonZeros());
+    for (int b = 0; b < sparse.rows(); ++b) {
+        ASSERT_EQ(back.row(b).size(), sparse.row(b).size());
+        for (size_t k = 0; k < sparse.row(b).size(); ++k) ASSERT_EQ(back.row(b)[k], sparse.row(b)[k]);
+    }
+}
+
+TEST(SparseForwardMatchesDense) {
+    nn::Network net = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 16, 3}, nn::ActivationType::SIGMOID);
+    nn::SparseBatch sparse = makeSparse();
+
+    nn::Matrix a = net.forwardBatch(sparse.toDense());
+    nn::Matrix b = net.forwardBatch(sparse);
+    for (int r = 0; r < a.rows(); ++r) {
+        for (int k = 0; k < a.cols(); ++k) ASSERT_NEAR(a(r, k), b(r, k), TOLERANCE);
+    }
+}
+
+TEST(SparseTrainingMatchesDense) {
+    nn::Network dense = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 16, 3}, nn::ActivationType::SIGMOID);
+    nn::Network sparse = dense;
+    nn::SparseBatch inputs = makeSparse();
+    nn::Matrix denseInputs = inputs.toDense();
+    nn::Matrix targets(inputs.rows(), 3);
+    for (int b = 0; b < inputs.rows(); ++b) targets(b, b % 3) = 1.0;
+
+    nn::ParallelTrainer denseTrainer(dense, 2);
+    nn::ParallelTrainer sparseTrainer(sparse, 2);
+    for (int step = 0; step < 3; ++step) {
+        auto a = denseTrainer.trainBatch(denseInputs, targets, 0.1);
+        auto b = sparseTrainer.trainBatch(inputs, targets, 0.1);
+        ASSERT_NEAR(a.loss, b.loss, TOLERANCE * 10);
+        ASSERT_EQ(a.correct, b.correct);
+    }
+
+    nn::Matrix a = dense.forwardBatch(denseInputs);
+    nn::Matrix b = sparse.forwardBatch(inputs);
+    for (int r = 0; r < a.rows(); ++r) {
+        for (int k = 0; k < a.cols(); ++k) ASSERT_NEAR(a(r, k), b(r, k), TOLERANCE * 10);
+    }
+}
+
+TEST(SparseInputIsValidated) {
+    nn::SparseBatch batch(10);
+    bool threw = false;
+    try {
+        batch.addRow(std::vector<int>{3, 10});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+    ASSERT_EQ(batch.rows(), 0);
+
+    // Seule la première couche range ses poids [input][output]
+    nn::Network net = test_helpers::makeNetwork({analyzer::FENParser::FEATURE_COUNT, 16, 3}, nn::ActivationType::SIGMOID);
+    ASSERT_TRUE(net.layer(0).hasSparseInput());
+    ASSERT_TRUE(!net.layer(1).hasSparseInput());
+    ASSERT_EQ(net.layer(0).getWeights().rows(), analyzer::FENParser::FEATURE_COUNT);
+
+    // Batch d'une autre largeur que la couche : refusé avant toute lecture des poids
+    batch.addRow(std::vector<int>{1, 2});
+    threw = false;
+    try {
+        net.forwardBatch(batch);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    const std::vector<int> outside = {0, analyzer::FENParser::FEATURE_COUNT};
+    threw = false;
+    try {
+        net.infer(std::span<const int>(outside));
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+}
@@ -0,0 +1,94 @@
+#include "unit_test.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/Trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+int countOf(const std::string& text, const std::string& pattern) {
+    int count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) count++;
+    return count;
+}
+
+} // namespace
+
+TEST(TraceWritesSpansPerThread) {
+    const std::string path = "test_trace.json";
+    {
+        MYTORCH_TRACE_SCOPE("before");              // Hors trace : non enregistré
+    }
+    nn::trace::start(path);
+    {
+        MYTORCH_TRACE_SCOPE("outer");
+        MYTORCH_TRACE_COUNTERS("inner");            // Avec ou sans perf_event : le span est écrit
+    }
+    std::thread worker([] {
+        nn::trace::setThreadName("test worker");
+        MYTORCH_PROFILE_SCOPE(nn::profile::FORWARD, 0);
+    });
+    worker.join();
+    const size_t events = nn::trace::stop();
+    ASSERT_EQ(nn::trace::stop(), 0u);
+    {
+        MYTORCH_TRACE_SCOPE("after");
+    }
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string json = content.str();
+    std::remove(path.c_str());
+
+    ASSERT_EQ(events, nn::profile::AVAILABLE ? 3u : 2u);
+    ASSERT_EQ(countOf(json, "\"ph\":\"X\""), static_cast<int>(events));
+    ASSERT_EQ(countOf(json, "\"name\":\"outer\""), 1);
+    ASSERT_EQ(countOf(json, "\"name\":\"before\""), 0);
+    ASSERT_EQ(countOf(json, "\"name\":\"after\""), 0);
+    if (nn::profile::AVAILABLE) {
+        ASSERT_EQ(countOf(json, "\"name\":\"forward L1\""), 1);
+        ASSERT_EQ(countOf(json, "\"name\":\"test worker\""), 1);
+    }
+    // inner, et forward L1 quand les sondes de profilage sont compilées (PROFILE=1)
+    const int counterSpans = nn::profile::AVAILABLE ? 2 : 1;
+    ASSERT_EQ(countOf(json, "\"args\":{\"cycles\""), nn::trace::countersAvailable() ? counterSpans : 0);
+    ASSERT_TRUE(json.find("\"traceEvents\":[") != std::string::npos);
+    ASSERT_TRUE(json.find("\"dropped_events\":0}}") != std::string::npos);
+}
+
+TEST(TraceReusesBuffersOfFinishedThreads) {
+    // Un thread par passe, comme le prefetcher : une seule ligne et un seul tampon pour tous
+    const std::string path = "test_trace_reuse.json";
+    nn::trace::start(path);
+    for (int pass = 0; pass < 3; ++pass) {
+        std::thread worker([] {
+            nn::trace::setThreadName("test pass");
+            MYTORCH_TRACE_COUNTERS("pass");
+        });
+        worker.join();
+    }
+    std::thread other([] {
+        nn::trace::setThreadName("test other");
+        MYTORCH_TRACE_SCOPE("other");
+    });
+    other.join();
+    ASSERT_EQ(nn::trace::stop(), 4u);
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    const std::string json = content.str();
+    std::remove(path.c_str());
+
+    ASSERT_EQ(countOf(json, "\"name\":\"test pass\""), 1);
+    ASSERT_EQ(countOf(json, "\"name\":\"pass\""), 3);
+    ASSERT_EQ(countOf(json, "\"name\":\"test other\""), 1);
+    // Les trois spans de passe sont sur la ligne du tampon repris
+    const size_t meta = json.find("\"name\":\"test pass\"");
+    const size_t tidStart = json.rfind("\"tid\":", meta);
+    const std::string tid = json.substr(tidStart, json.find(',', tidStart) - tidStart);
+    ASSERT_EQ(countOf(json, "\"name\":\"pass\",\"ph\":\"X\",\"pid\":1," + tid + ","), 3);
+}
@@ -10,7 +10,7 @@ TEST(XORConvergence) {
     // 0,1 -> 1
     // 1,0 -> 1
     // 1,1 -> 0
-    std::vector<std::pair<std::vector<double>, std::vector<double>>> data = {
+    std::vector<std::pair<nn::Vector, nn::Vector>> data = {
         {{0.0, 0.0}, {0.0}},
         {{0.0, 1.0}, {1.0}},
         {{1.0, 0.0}, {1.0}},